@@ -101,11 +101,27 @@ MakoBiteAudioProcessorEditor::MakoBiteAudioProcessorEditor (MakoBiteAudioProcess
     // editor's size to whatever you need it to be.
     
     //R1.00 Set the window size.
-    setSize(540, 180);
+    //R1.02 We draw every pixel so JUCE does not need to paint what is behind us.
+    setOpaque(true);
+    setSize(540, Scope_Top + Scope_Height);
+
+    //R1.02 Hann window for the spectrum.
+    for (int t = 0; t < Scope_FFTSize; t++) FFT_Window[t] = .5f - .5f * cosf(6.2831853f * float(t) / float(Scope_FFTSize));
+    for (int t = 0; t < Scope_FFTSize / 2; t++) Spec_In[t] = Spec_Out[t] = -90.0f;
+
+    //R1.02 Start the scope. The audio thread only feeds it while Scope_Active is set.
+    audioProcessor.Scope_Active.store(true);
+    startTimerHz(30);
 }
 
 MakoBiteAudioProcessorEditor::~MakoBiteAudioProcessorEditor()
 {
+    //R1.02 Stop all scope work when the editor closes.
+    stopTimer();
+    audioProcessor.Scope_Active.store(false);
+
+    //R1.02 And wait for any knob atlas still being drawn.
+    myLookAndFeel.Mako_Atlas_Stop();
 }
 
 //==============================================================================
@@ -113,7 +129,41 @@ void MakoBiteAudioProcessorEditor::paint (juce::Graphics& g)
 {
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     //g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-    
+
+    //R1.02 Rebuild the background if we moved to a screen with a different scale.
+    float Scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if ((! imgComposite.isValid()) || (Scale != Composite_Scale)) Mako_Build_Background(Scale, {});
+
+    //R1.02 Only blit the part being repainted. A knob move only needs the area under that knob.
+    auto Area = g.getClipBounds().getIntersection({ 0, 0, 540, 180 });
+    if (! Area.isEmpty())
+    {
+        int Sx = int(floorf(Area.getX() * Scale));
+        int Sy = int(floorf(Area.getY() * Scale));
+        int Sw = int(ceilf(Area.getRight() * Scale)) - Sx;
+        int Sh = int(ceilf(Area.getBottom() * Scale)) - Sy;
+        g.drawImage(imgComposite, Area.getX(), Area.getY(), Area.getWidth(), Area.getHeight(), Sx, Sy, Sw, Sh);
+    }
+
+    //R1.02 Scope panel.
+    if (g.getClipBounds().intersects({ 0, Scope_Top, 540, Scope_Height })) Mako_Draw_Scope(g);
+}
+
+//R1.02 Draw the background image and all of the knob text into one image at the screen scale.
+//R1.02 With an Area, only that part of the existing image is redrawn.
+void MakoBiteAudioProcessorEditor::Mako_Build_Background(float Scale, juce::Rectangle<int> Area)
+{
+    bool Full = Area.isEmpty() || (! imgComposite.isValid()) || (Scale != Composite_Scale);
+    if (Full)
+    {
+        imgComposite = juce::Image(juce::Image::RGB, int(540 * Scale), int(180 * Scale), true);
+        Composite_Scale = Scale;
+    }
+
+    juce::Graphics g(imgComposite);
+    g.addTransform(juce::AffineTransform::scale(Scale));
+    if (! Full) g.reduceClipRegion(Area);
+
     bool UseImage = true;
     juce::ColourGradient ColGrad;
 
@@ -156,14 +206,14 @@ void MakoBiteAudioProcessorEditor::paint (juce::Graphics& g)
     }
     
     //R1.00 DRAW TEXT.
-    //R1.00 Most of these could be done on the image to speed up painting.
-    //R1.00 But the EQ frequencies need to update. So we are doing all the text
-    //R1.00 here so the font matches no matter what in the future.
+    //R1.02 The text is drawn onto our composite image. The EQ frequencies only change
+    //R1.02 when the EQ mode changes, and then only their labels are redrawn.
     g.setFont(12.0f);
     g.setColour(juce::Colours::black);
     for (int t = 0; t < Knob_Cnt; t++)
     {
-        g.drawFittedText(Knob_Name[t], Knob_Pos[t].x, Knob_Pos[t].y - 10, Knob_Pos[t].sizex, 15, juce::Justification::centred, 1);
+        if (! Full && ! Area.intersects(Mako_Label_Bounds(t))) continue;
+        g.drawFittedText(Knob_Name[t], Mako_Label_Bounds(t), juce::Justification::centred, 1);
     }
 
     //R1.01 Draw IR off text.
@@ -183,6 +233,237 @@ void MakoBiteAudioProcessorEditor::resized()
 }
 
 
+//R1.02 Simple in place radix 2 FFT. N must be a power of 2.
+static void Mako_FFT(float* Re, float* Im, int N)
+{
+    //R1.02 Bit reverse the order.
+    for (int i = 1, j = 0; i < N; i++)
+    {
+        int bit = N >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j)
+        {
+            std::swap(Re[i], Re[j]);
+            std::swap(Im[i], Im[j]);
+        }
+    }
+
+    //R1.02 Butterflies.
+    for (int Len = 2; Len <= N; Len <<= 1)
+    {
+        float Ang = -6.2831853f / float(Len);
+        float wRe = cosf(Ang);
+        float wIm = sinf(Ang);
+        for (int i = 0; i < N; i += Len)
+        {
+            float cRe = 1.0f;
+            float cIm = 0.0f;
+            for (int k = 0; k < Len / 2; k++)
+            {
+                int a = i + k;
+                int b = a + Len / 2;
+                float tRe = Re[b] * cRe - Im[b] * cIm;
+                float tIm = Re[b] * cIm + Im[b] * cRe;
+                Re[b] = Re[a] - tRe;
+                Im[b] = Im[a] - tIm;
+                Re[a] += tRe;
+                Im[a] += tIm;
+                float nRe = cRe * wRe - cIm * wIm;
+                cIm = cRe * wIm + cIm * wRe;
+                cRe = nRe;
+            }
+        }
+    }
+}
+
+//R1.02 Grab new scope samples, update the spectrum, and repaint only the scope panel.
+void MakoBiteAudioProcessorEditor::timerCallback()
+{
+    int Total = 0;
+    int Count;
+
+    //R1.02 Empty the FIFOs. We only keep the last 1024 samples.
+    do
+    {
+        Count = audioProcessor.Mako_Scope_Pull(Scope_TmpIn, Scope_TmpOut, 2048);
+        for (int t = 0; t < Count; t++)
+        {
+            Scope_HistIn[Scope_HistPos] = Scope_TmpIn[t];
+            Scope_HistOut[Scope_HistPos] = Scope_TmpOut[t];
+            Scope_HistPos = (Scope_HistPos + 1) & (Scope_FFTSize - 1);
+        }
+        Total += Count;
+    } while (Count == 2048);
+
+    if (0 < Total)
+    {
+        Mako_Spectrum_Calc(Scope_HistIn, Spec_In);
+        Mako_Spectrum_Calc(Scope_HistOut, Spec_Out);
+    }
+
+    //R1.02 Only recalc the response curve when the processor changed the filters.
+    bool RespChanged = Mako_Resp_Calc();
+
+    //R1.02 Show when the CPU governor has lowered the quality.
+    int Gov = audioProcessor.Gov_Level_Now.load();
+    bool GovChanged = (Gov != Gov_Level_Last);
+    Gov_Level_Last = Gov;
+
+    if ((0 < Total) || RespChanged || GovChanged) repaint(0, Scope_Top, 540, Scope_Height);
+}
+
+//R1.02 Windowed FFT of our sample history. Peaks fall slowly so the display is readable.
+void MakoBiteAudioProcessorEditor::Mako_Spectrum_Calc(const float* Hist, float* Spec)
+{
+    float Re[Scope_FFTSize];
+    float Im[Scope_FFTSize];
+
+    for (int t = 0; t < Scope_FFTSize; t++)
+    {
+        Re[t] = Hist[(Scope_HistPos + t) & (Scope_FFTSize - 1)] * FFT_Window[t];
+        Im[t] = 0.0f;
+    }
+
+    Mako_FFT(Re, Im, Scope_FFTSize);
+
+    //R1.02 Scale so a full volume sine is about 0dB. The Hann window halves the level.
+    float Norm = 4.0f / float(Scope_FFTSize);
+    for (int t = 0; t < Scope_FFTSize / 2; t++)
+    {
+        float Mag = (Re[t] * Re[t] + Im[t] * Im[t]) * Norm * Norm;
+        float dB = 10.0f * log10f(Mag + 1.0e-12f);
+        Spec[t] = juce::jmax(dB, Spec[t] - 1.5f);
+    }
+}
+
+//R1.02 Combined magnitude response of the EQ bands and High Cut. Returns true if it changed.
+bool MakoBiteAudioProcessorEditor::Mako_Resp_Calc()
+{
+    float Coeffs[6][5];
+    bool Active[6];
+    int Version = audioProcessor.Resp_Version.load(std::memory_order_acquire);
+
+    if ((Version == Resp_Version_Last) || (Version & 1)) return false;
+
+    //R1.02 Copy the coefficients. If the audio thread changed them while we copied, try again next timer.
+    auto Relaxed = std::memory_order_relaxed;
+    for (int f = 0; f < 6; f++)
+    {
+        Active[f] = audioProcessor.Resp_Active[f].load(Relaxed);
+        for (int c = 0; c < 5; c++) Coeffs[f][c] = audioProcessor.Resp_Coeffs[f][c].load(Relaxed);
+    }
+    float SR = audioProcessor.Resp_SampleRate.load(Relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (audioProcessor.Resp_Version.load(Relaxed) != Version) return false;
+    Resp_Version_Last = Version;
+
+    //R1.02 128 points from 20Hz up to 20kHz or just below Nyquist.
+    float FMax = juce::jmin(20000.0f, SR * .45f);
+    for (int p = 0; p < 128; p++)
+    {
+        float Freq = 20.0f * powf(FMax / 20.0f, float(p) / 127.0f);
+        float w = 6.2831853f * Freq / SR;
+        float c1 = cosf(w), s1 = sinf(w);
+        float c2 = cosf(w * 2.0f), s2 = sinf(w * 2.0f);
+        float dB = 0.0f;
+
+        for (int f = 0; f < 6; f++)
+        {
+            if (! Active[f]) continue;
+
+            //R1.02 H = (a0 + a1 z^-1 + a2 z^-2) / (1 + b1 z^-1 + b2 z^-2)
+            float nRe = Coeffs[f][0] + Coeffs[f][1] * c1 + Coeffs[f][2] * c2;
+            float nIm = -(Coeffs[f][1] * s1 + Coeffs[f][2] * s2);
+            float dRe = 1.0f + Coeffs[f][3] * c1 + Coeffs[f][4] * c2;
+            float dIm = -(Coeffs[f][3] * s1 + Coeffs[f][4] * s2);
+            dB += 10.0f * log10f((nRe * nRe + nIm * nIm + 1.0e-12f) / (dRe * dRe + dIm * dIm + 1.0e-12f));
+        }
+
+        Resp_Freq[p] = Freq;
+        Resp_dB[p] = dB;
+    }
+
+    return true;
+}
+
+//R1.02 Draw the scope (left) and spectrum (right) under the amp.
+void MakoBiteAudioProcessorEditor::Mako_Draw_Scope(juce::Graphics& g)
+{
+    const float Top = float(Scope_Top + 5);
+    const float Hgt = float(Scope_Height - 10);
+    const float ScopeX = 10.0f, ScopeW = 255.0f;
+    const float SpecX = 275.0f, SpecW = 255.0f;
+    juce::Path P;
+
+    g.setColour(juce::Colour(0xFF202020));
+    g.fillRect(0, Scope_Top, 540, Scope_Height);
+    g.setColour(juce::Colour(0xFF000000));
+    g.fillRect(ScopeX, Top, ScopeW, Hgt);
+    g.fillRect(SpecX, Top, SpecW, Hgt);
+
+    //R1.02 SCOPE - The last 510 samples, 2 per pixel. Input grey, output orange.
+    float Mid = Top + Hgt * .5f;
+    const float* Hists[2] = { Scope_HistIn, Scope_HistOut };
+    juce::Colour Cols[2] = { juce::Colour(0xFF808080), juce::Colour(0xFFFF8000) };
+    for (int h = 0; h < 2; h++)
+    {
+        P.clear();
+        for (int t = 0; t < 510; t++)
+        {
+            float V = juce::jlimit(-1.0f, 1.0f, Hists[h][(Scope_HistPos - 510 + t) & (Scope_FFTSize - 1)]);
+            float Px = ScopeX + float(t) * .5f;
+            float Py = Mid - V * Hgt * .48f;
+            if (t == 0) P.startNewSubPath(Px, Py); else P.lineTo(Px, Py);
+        }
+        g.setColour(Cols[h]);
+        g.strokePath(P, juce::PathStrokeType(1.0f));
+    }
+
+    //R1.02 SPECTRUM - Log frequency, -90dB to 0dB. The scope rate is already decimated, so the axis
+    //R1.02 ends at its Nyquist and bin t is at t * rate / FFT size. The EQ curve uses the same axis.
+    float FMin = 20.0f;
+    float Rate = audioProcessor.Scope_SampleRate.load();
+    float FMax = Rate * .5f;
+    float LogSpan = logf(FMax / FMin);
+    const float* Specs[2] = { Spec_In, Spec_Out };
+    for (int h = 0; h < 2; h++)
+    {
+        P.clear();
+        bool First = true;
+        for (int t = 1; t < Scope_FFTSize / 2; t++)
+        {
+            float Freq = float(t) * Rate / float(Scope_FFTSize);
+            if (Freq < FMin) continue;
+            float Px = SpecX + SpecW * logf(Freq / FMin) / LogSpan;
+            float Py = Top + Hgt * juce::jlimit(0.0f, 1.0f, -Specs[h][t] / 90.0f);
+            if (First) P.startNewSubPath(Px, Py); else P.lineTo(Px, Py);
+            First = false;
+        }
+        g.setColour(Cols[h]);
+        g.strokePath(P, juce::PathStrokeType(1.0f));
+    }
+
+    //R1.02 EQ and High Cut response. +-24dB around the middle line.
+    P.clear();
+    for (int p = 0; p < 128; p++)
+    {
+        float Px = SpecX + SpecW * juce::jlimit(0.0f, 1.0f, logf(juce::jmax(Resp_Freq[p], FMin) / FMin) / LogSpan);
+        float Py = Mid - Hgt * .5f * juce::jlimit(-1.0f, 1.0f, Resp_dB[p] / 24.0f);
+        if (p == 0) P.startNewSubPath(Px, Py); else P.lineTo(Px, Py);
+    }
+    g.setColour(juce::Colour(0xFF40C040));
+    g.strokePath(P, juce::PathStrokeType(1.5f));
+
+    //R1.02 CPU governor level. Nothing is shown at full quality.
+    if (0 < Gov_Level_Last)
+    {
+        g.setFont(10.0f);
+        g.setColour(juce::Colours::yellow);
+        g.drawText("CPU SAVER " + juce::String(Gov_Level_Last), int(SpecX + SpecW) - 85, int(Top) + 2, 80, 12, juce::Justification::right, true);
+    }
+}
+
 //R1.00 Setup the SLIDER control edit values, Text Suffix (if any), UI tick marks, and Indicator Color.
 void MakoBiteAudioProcessorEditor::Mako_Init_Large_Slider(juce::Slider* slider, float Val, float Vmin, float Vmax, float Vinterval, juce::String Suffix, int TickStyle, int ThumbColor)
 {
@@ -294,178 +575,31 @@ void MakoBiteAudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
     return;
 }
 
-//R1.01 Select the EQ frequencies and Qs. Must match the processor code.
+//R1.01 Select the EQ frequencies and Qs.
+//R1.02 From the processor's table, so the labels always match what is playing. The processor sets its own bands.
 void MakoBiteAudioProcessorEditor::Mako_Band_SetFilterValues(bool ForcePaint)
 {
-    int EQ_Mode = int(audioProcessor.Setting[e_EQ]);
+    float Freq[5];
+    float Q[5];
+    MakoBiteAudioProcessor::Mako_Band_GetValues(int(audioProcessor.Setting[e_EQ]), Freq, Q);
 
-    //R1.01 Define the user selected EQ mode.
-    switch (EQ_Mode)
-    {
-    default:
-    {
-        audioProcessor.Band1_Freq = 150.0f;
-        audioProcessor.Band2_Freq = 300.0f;
-        audioProcessor.Band3_Freq = 750.0f;
-        audioProcessor.Band4_Freq = 1500.0f;
-        audioProcessor.Band5_Freq = 3000.0f;
-        audioProcessor.Band1_Q = .707f;
-        audioProcessor.Band2_Q = 1.414f;
-        audioProcessor.Band3_Q = 1.414f;
-        audioProcessor.Band4_Q = 1.414f;
-        audioProcessor.Band5_Q = 1.414f;
-        break;
-    }
-    case 1:
-    {
-        audioProcessor.Band1_Freq = 150.0f;
-        audioProcessor.Band2_Freq = 450.0f;
-        audioProcessor.Band3_Freq = 900.0f;
-        audioProcessor.Band4_Freq = 1800.0f;
-        audioProcessor.Band5_Freq = 3500.0f;
-        audioProcessor.Band1_Q = .707f;
-        audioProcessor.Band2_Q = 1.414f;
-        audioProcessor.Band3_Q = 1.414f;
-        audioProcessor.Band4_Q = 1.414f;
-        audioProcessor.Band5_Q = 1.414f;
-        break;
-    }
-    case 2:
-    {
-        audioProcessor.Band1_Freq = 80.0f;
-        audioProcessor.Band2_Freq = 220.0f;
-        audioProcessor.Band3_Freq = 750.0f;
-        audioProcessor.Band4_Freq = 2200.0f;
-        audioProcessor.Band5_Freq = 6000.0f;
-        audioProcessor.Band1_Q = .707f;
-        audioProcessor.Band2_Q = 1.414f;
-        audioProcessor.Band3_Q = 1.414f;
-        audioProcessor.Band4_Q = 1.414f;
-        audioProcessor.Band5_Q = 1.414f;
-        break;
-    }
-    case 3:
-    {
-        audioProcessor.Band1_Freq = 80.0f;
-        audioProcessor.Band2_Freq = 350.0f;
-        audioProcessor.Band3_Freq = 900.0f;
-        audioProcessor.Band4_Freq = 1500.0f;
-        audioProcessor.Band5_Freq = 3000.0f;
-        audioProcessor.Band1_Q = .707f;
-        audioProcessor.Band2_Q = 1.414f;
-        audioProcessor.Band3_Q = 1.414f;
-        audioProcessor.Band4_Q = 1.414f;
-        audioProcessor.Band5_Q = 1.414f;
-        break;
-    }
-    case 4:
-    {
-        audioProcessor.Band1_Freq = 100.0f;
-        audioProcessor.Band2_Freq = 400.0f;
-        audioProcessor.Band3_Freq = 800.0f;
-        audioProcessor.Band4_Freq = 1600.0f;
-        audioProcessor.Band5_Freq = 3200.0f;
-        audioProcessor.Band1_Q = .707f;
-        audioProcessor.Band2_Q = 1.414f;
-        audioProcessor.Band3_Q = 1.414f;
-        audioProcessor.Band4_Q = 1.414f;
-        audioProcessor.Band5_Q = 1.414f;
-        break;
-    }
-    case 5:
-    {
-        audioProcessor.Band1_Freq = 120.0f;
-        audioProcessor.Band2_Freq = 330.0f;
-        audioProcessor.Band3_Freq = 660.0f;
-        audioProcessor.Band4_Freq = 1320.0f;
-        audioProcessor.Band5_Freq = 2500.0f;
-        audioProcessor.Band1_Q = .707f;
-        audioProcessor.Band2_Q = 1.414f;
-        audioProcessor.Band3_Q = .707f;
-        audioProcessor.Band4_Q = 1.414f;
-        audioProcessor.Band5_Q = .707f;
-        break;
-    }
-    case 6:
-    {
-        audioProcessor.Band1_Freq = 150.0f;
-        audioProcessor.Band2_Freq = 500.0f;
-        audioProcessor.Band3_Freq = 900.0f;
-        audioProcessor.Band4_Freq = 1800.0f;
-        audioProcessor.Band5_Freq = 5000.0f;
-        audioProcessor.Band1_Q = 1.414f;
-        audioProcessor.Band2_Q = .707f;
-        audioProcessor.Band3_Q = 1.414f;
-        audioProcessor.Band4_Q = 1.414f;
-        audioProcessor.Band5_Q = .707f;
-        break;
-    }
-    case 7:
-    {
-        audioProcessor.Band1_Freq = 80.0f;
-        audioProcessor.Band2_Freq = 300.0f;
-        audioProcessor.Band3_Freq = 650.0f;
-        audioProcessor.Band4_Freq = 1500.0f;
-        audioProcessor.Band5_Freq = 5000.0f;
-        audioProcessor.Band1_Q = 1.414f;
-        audioProcessor.Band2_Q = .707f;
-        audioProcessor.Band3_Q = 2.00f;
-        audioProcessor.Band4_Q = 1.414f;
-        audioProcessor.Band5_Q = .707f;
-        break;
-    }
-    case 8:
-    {
-        audioProcessor.Band1_Freq = 100.0f;
-        audioProcessor.Band2_Freq = 400.0f;
-        audioProcessor.Band3_Freq = 800.0f;
-        audioProcessor.Band4_Freq = 1500.0f;
-        audioProcessor.Band5_Freq = 5000.0f;
-        audioProcessor.Band1_Q = .707f;
-        audioProcessor.Band2_Q = .707f;
-        audioProcessor.Band3_Q = 1.414f;
-        audioProcessor.Band4_Q = 2.00f;
-        audioProcessor.Band5_Q = .35f;
-        break;
-    }
-    case 9:
-    {
-        audioProcessor.Band1_Freq = 80.0f;
-        audioProcessor.Band2_Freq = 500.0f;
-        audioProcessor.Band3_Freq = 1000.0f;
-        audioProcessor.Band4_Freq = 2000.0f;
-        audioProcessor.Band5_Freq = 5000.0f;
-        audioProcessor.Band1_Q = .707f;
-        audioProcessor.Band2_Q = 1.414f;
-        audioProcessor.Band3_Q = .707f;
-        audioProcessor.Band4_Q = .707f;
-        audioProcessor.Band5_Q = .350f;
-        break;
-    }
-    case 10:
-    {
-        audioProcessor.Band1_Freq = 80.0f;
-        audioProcessor.Band2_Freq = 250.0f;
-        audioProcessor.Band3_Freq = 750.0f;
-        audioProcessor.Band4_Freq = 1800.0f;
-        audioProcessor.Band5_Freq = 5000.0f;
-        audioProcessor.Band1_Q = 2.000f;
-        audioProcessor.Band2_Q = .707f;
-        audioProcessor.Band3_Q = 2.00f;
-        audioProcessor.Band4_Q = 1.414f;
-        audioProcessor.Band5_Q = .350f;
-        break;
-    }
+    juce::String OldNames[5];
+    for (int b = 0; b < 5; b++) OldNames[b] = Knob_Name[e_EQ1 + b];
 
-    }
+    Knob_Name[e_EQ1] = std::to_string(int(Freq[0]));
+    Knob_Name[e_EQ2] = std::to_string(int(Freq[1]));
+    Knob_Name[e_EQ3] = std::to_string(int(Freq[2]));
+    Knob_Name[e_EQ4] = std::to_string(int(Freq[3]));
+    Knob_Name[e_EQ5] = std::to_string(int(Freq[4]));
 
-    Knob_Name[e_EQ1] = std::to_string(int(audioProcessor.Band1_Freq));
-    Knob_Name[e_EQ2] = std::to_string(int(audioProcessor.Band2_Freq));
-    Knob_Name[e_EQ3] = std::to_string(int(audioProcessor.Band3_Freq));
-    Knob_Name[e_EQ4] = std::to_string(int(audioProcessor.Band4_Freq));
-    Knob_Name[e_EQ5] = std::to_string(int(audioProcessor.Band5_Freq));
+    //R1.02 Redraw and repaint only the labels that changed.
+    for (int b = 0; b < 5; b++)
+    {
+        if (OldNames[b] == Knob_Name[e_EQ1 + b]) continue;
+        if (imgComposite.isValid()) Mako_Build_Background(Composite_Scale, Mako_Label_Bounds(e_EQ1 + b));
 
-    //R1.01 We changed some stuff so refresh the screen/UI.
-    if (ForcePaint) repaint();
+        //R1.01 We changed some stuff so refresh the screen/UI.
+        if (ForcePaint) repaint(Mako_Label_Bounds(e_EQ1 + b));
+    }
 
 }
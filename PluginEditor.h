@@ -43,6 +43,9 @@ private:
     float TICK_Sin[11] = {};
     
 public:
+    //R1.02 Stop drawing atlases. Blocks until the atlas thread has finished.
+    void Mako_Atlas_Stop() { Atlas_Thread.stopThread(2000); }
+
     MakoLookAndFeel()
     {        
         //R1.00 Do some PRECALC on Sin/Cos since they are expensive on CPU.
@@ -99,52 +102,242 @@ public:
     }
 
     //R1.01 This override draws our small horizontal sliders ONLY. 
+    //R1.02 The recessed track and the slider knob are pre-drawn images. Drawing is two image copies.
     void drawLinearSlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float minSliderPos, float maxSliderPos, juce::Slider::SliderStyle, juce::Slider& sld) override
     {              
         float radius = height / 2;
         float rad2 = radius / 2;
         int Ymid = y + (height / 2);
-        juce::ColourGradient ColGrad;
         float Xpos = x + sliderPos - minSliderPos - rad2;
 
-        //R1.01 Draw recessed area.
-        ColGrad = juce::ColourGradient(juce::Colour(0xFF808080), 0.0f, y, juce::Colour(0xFFE0E0E0), 0.0f, y + height, false);
-        g.setGradientFill(ColGrad);
-        g.fillRoundedRectangle(x - 7, Ymid - 6,width + 14, 12, 3);
+        //R1.02 Draw the sprites again if the size or screen scale changed.
+        float Scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if ((width != Lin_Width) || (height != Lin_Height) || (Scale != Lin_Scale)) Mako_Render_Linear(width, height, Scale);
 
-        //R1.01 Draw the slider slot.
-        g.setColour(juce::Colour(0xFF000000));
-        g.drawLine(x, Ymid, x + width, Ymid, 3);
-        
-        //R1.01 Draw the actual slider knob.  
-        g.setColour(juce::Colour(0xFFFF8000));
-        ColGrad = juce::ColourGradient(juce::Colour(0xFFFF8000), 0.0f, y, juce::Colour(0xFF804000), 0.0f, y + height, false);
-        g.setGradientFill(ColGrad);
-        g.fillRoundedRectangle(Xpos, Ymid - rad2 - 1, radius, radius + 2, 3);
-        
-        //R1.01 Add a lighting highlight on the knob.  
-        g.setColour(juce::Colour(0xFFFFC080));
-        g.drawLine(Xpos + 2, Ymid - 4, Xpos + 5, Ymid - 5, 1);
+        //R1.02 Sprites have a 2 pixel border so anti-aliased edges are not cut off.
+        g.drawImageTransformed(imgLinTrack, juce::AffineTransform::scale(1.0f / Scale).translated(float(x - 7 - 2), float(Ymid - 6 - 2)));
+        g.drawImageTransformed(imgLinThumb, juce::AffineTransform::scale(1.0f / Scale).translated(Xpos - 2.0f, float(Ymid) - rad2 - 1.0f - 2.0f));
     }
 
     //R1.00 Override the Juce SLIDER drawing function so our code gets called instead of Juces code.
+    //R1.02 Enabled knobs are copied from a pre-drawn atlas of 128 rotation frames.
+    //R1.02 The atlas is drawn on a background thread the first time a knob style is seen. Until it is ready we draw the knob by hand.
     void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, const float rotaryStartAngle, const float rotaryEndAngle, juce::Slider& sld) override
+    {
+        //R1.00 We are cheating and using the rotarySliderOutlineColourId as a tick mark style selector.
+        int TickStyle = int(sld.findColour(juce::Slider::rotarySliderOutlineColourId).getARGB());
+        juce::Colour Thumb = sld.findColour(juce::Slider::thumbColourId);
+
+        if (sld.isEnabled())
+        {
+            float Scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+            auto Atlas = Mako_Get_Atlas(width, height, Scale, TickStyle, Thumb.getARGB(), rotaryStartAngle, rotaryEndAngle);
+
+            if (Atlas->Ready.load())
+            {
+                //R1.02 Copy our frame from the atlas.
+                int Frame = juce::jlimit(0, Atlas_Frames - 1, int(sliderPos * float(Atlas_Frames - 1) + .5f));
+                int FW = Atlas->FrameW;
+                int FH = Atlas->FrameH;
+                g.drawImage(Atlas->Frames, x, y, width, height, (Frame % Atlas_Cols) * FW, (Frame / Atlas_Cols) * FH, FW, FH);
+                return;
+            }
+        }
+
+        auto angle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle); //R1.00 Bizarre values here 216(36) to 504(324).
+        Mako_Draw_Knob(g, x, y, width, height, angle, TickStyle, Thumb, sld.isEnabled(), pathKnob, TICK_Sin, TICK_Cos);
+    }
+
+private:
+    //R1.02 Knob atlas layout. 128 frames in 16 columns by 8 rows.
+    static const int Atlas_Frames = 128;
+    static const int Atlas_Cols = 16;
+
+    //R1.02 One pre-drawn knob style. Everything the background thread needs is copied in here.
+    struct t_KnobAtlas {
+        int Width = 0;
+        int Height = 0;
+        int FrameW = 0;
+        int FrameH = 0;
+        float Scale = 1.0f;
+        int TickStyle = 0;
+        juce::uint32 Thumb = 0;
+        float StartAngle = 0.0f;
+        float EndAngle = 0.0f;
+        juce::Path Knob;
+        float TickSin[11] = {};
+        float TickCos[11] = {};
+        juce::Image Frames;
+        std::atomic<bool> Ready { false };
+    };
+
+    std::vector<std::shared_ptr<t_KnobAtlas>> Atlases;
+
+    //R1.02 Draws the waiting atlases one at a time. Owned by the look and feel, so the editor
+    //R1.02 stops and joins it before anything it draws into can go away.
+    class t_AtlasThread : public juce::Thread
+    {
+    public:
+        t_AtlasThread() : juce::Thread("Mako Rusty Atlas") {}
+        ~t_AtlasThread() override { stopThread(2000); }
+
+        void Add(std::shared_ptr<t_KnobAtlas> A)
+        {
+            {
+                const juce::ScopedLock Lock(Pending_Lock);
+                Pending.push_back(A);
+            }
+            if (! isThreadRunning()) startThread(juce::Thread::Priority::low);
+            notify();
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                std::shared_ptr<t_KnobAtlas> A;
+                {
+                    const juce::ScopedLock Lock(Pending_Lock);
+                    if (! Pending.empty())
+                    {
+                        A = Pending.front();
+                        Pending.erase(Pending.begin());
+                    }
+                }
+
+                if (A == nullptr) wait(-1);
+                else Mako_Render_Atlas(*A, *this);
+            }
+        }
+
+    private:
+        juce::CriticalSection Pending_Lock;
+        std::vector<std::shared_ptr<t_KnobAtlas>> Pending;
+    };
+
+    t_AtlasThread Atlas_Thread;
+
+    //R1.02 Small slider sprites.
+    juce::Image imgLinTrack;
+    juce::Image imgLinThumb;
+    int Lin_Width = 0;
+    int Lin_Height = 0;
+    float Lin_Scale = 0.0f;
+
+    //R1.02 Find the atlas for this knob style. Create it and start drawing it if we have not seen it before.
+    std::shared_ptr<t_KnobAtlas> Mako_Get_Atlas(int width, int height, float Scale, int TickStyle, juce::uint32 Thumb, float StartAngle, float EndAngle)
+    {
+        for (auto& A : Atlases)
+        {
+            if ((A->Width == width) && (A->Height == height) && (A->Scale == Scale) && (A->TickStyle == TickStyle)
+                && (A->Thumb == Thumb) && (A->StartAngle == StartAngle) && (A->EndAngle == EndAngle)) return A;
+        }
+
+        auto A = std::make_shared<t_KnobAtlas>();
+        A->Width = width;
+        A->Height = height;
+        A->FrameW = int(std::ceil(width * Scale));
+        A->FrameH = int(std::ceil(height * Scale));
+        A->Scale = Scale;
+        A->TickStyle = TickStyle;
+        A->Thumb = Thumb;
+        A->StartAngle = StartAngle;
+        A->EndAngle = EndAngle;
+        A->Knob = pathKnob;
+        for (int t = 0; t < 11; t++)
+        {
+            A->TickSin[t] = TICK_Sin[t];
+            A->TickCos[t] = TICK_Cos[t];
+        }
+        Atlases.push_back(A);
+        Atlas_Thread.Add(A);
+
+        return A;
+    }
+
+    //R1.02 Atlas thread. Software images can be drawn on any thread. Gives up part way if the editor is closing.
+    static void Mako_Render_Atlas(t_KnobAtlas& A, const juce::Thread& T)
+    {
+        juce::Image Img(juce::Image::ARGB, A.FrameW * Atlas_Cols, A.FrameH * (Atlas_Frames / Atlas_Cols), true, juce::SoftwareImageType());
+        {
+            juce::Graphics gi(Img);
+            for (int f = 0; f < Atlas_Frames; f++)
+            {
+                if (T.threadShouldExit()) return;
+
+                float angle = A.StartAngle + (float(f) / float(Atlas_Frames - 1)) * (A.EndAngle - A.StartAngle);
+                gi.saveState();
+                gi.reduceClipRegion((f % Atlas_Cols) * A.FrameW, (f / Atlas_Cols) * A.FrameH, A.FrameW, A.FrameH);
+                gi.addTransform(juce::AffineTransform::scale(A.Scale).translated(float((f % Atlas_Cols) * A.FrameW), float((f / Atlas_Cols) * A.FrameH)));
+                Mako_Draw_Knob(gi, 0, 0, A.Width, A.Height, angle, A.TickStyle, juce::Colour(A.Thumb), true, A.Knob, A.TickSin, A.TickCos);
+                gi.restoreState();
+            }
+        }
+        A.Frames = Img;
+        A.Ready.store(true);
+    }
+
+    //R1.02 Draw the small slider track and knob sprites at the screen scale.
+    void Mako_Render_Linear(int width, int height, float Scale)
+    {
+        float radius = height / 2;
+        float rad2 = radius / 2;
+        juce::ColourGradient ColGrad;
+
+        Lin_Width = width;
+        Lin_Height = height;
+        Lin_Scale = Scale;
+
+        //R1.02 TRACK - Drawn from (x - 7, Ymid - 6). Plus a 2 pixel border.
+        float TrackW = float(width + 14);
+        imgLinTrack = juce::Image(juce::Image::ARGB, int(std::ceil((TrackW + 4.0f) * Scale)), int(std::ceil(16.0f * Scale)), true);
+        {
+            juce::Graphics g(imgLinTrack);
+            g.addTransform(juce::AffineTransform::translation(2.0f, 2.0f).scaled(Scale));
+
+            //R1.01 Draw recessed area.
+            ColGrad = juce::ColourGradient(juce::Colour(0xFF808080), 0.0f, float(6 - height / 2), juce::Colour(0xFFE0E0E0), 0.0f, float(6 + height - height / 2), false);
+            g.setGradientFill(ColGrad);
+            g.fillRoundedRectangle(0.0f, 0.0f, TrackW, 12.0f, 3.0f);
+
+            //R1.01 Draw the slider slot.
+            g.setColour(juce::Colour(0xFF000000));
+            g.drawLine(7.0f, 6.0f, 7.0f + width, 6.0f, 3.0f);
+        }
+
+        //R1.02 SLIDER KNOB - Drawn from (Xpos, Ymid - rad2 - 1). Plus a 2 pixel border.
+        imgLinThumb = juce::Image(juce::Image::ARGB, int(std::ceil((radius + 4.0f) * Scale)), int(std::ceil((radius + 6.0f) * Scale)), true);
+        {
+            juce::Graphics g(imgLinThumb);
+            g.addTransform(juce::AffineTransform::translation(2.0f, 2.0f).scaled(Scale));
+            float Top = float(height / 2) - rad2 - 1.0f;
+
+            //R1.01 Draw the actual slider knob.  
+            ColGrad = juce::ColourGradient(juce::Colour(0xFFFF8000), 0.0f, -Top, juce::Colour(0xFF804000), 0.0f, float(height) - Top, false);
+            g.setGradientFill(ColGrad);
+            g.fillRoundedRectangle(0.0f, 0.0f, radius, radius + 2.0f, 3.0f);
+
+            //R1.01 Add a lighting highlight on the knob.  
+            g.setColour(juce::Colour(0xFFFFC080));
+            g.drawLine(2.0f, rad2 - 3.0f, 5.0f, rad2 - 4.0f, 1.0f);
+        }
+    }
+
+    //R1.02 The original knob drawing code. Used to fill the atlas and while the atlas is being drawn.
+    static void Mako_Draw_Knob(juce::Graphics& g, int x, int y, int width, int height, float angle, int TickStyle, juce::Colour Thumb, bool Enabled, const juce::Path& pathKnob, const float* TICK_Sin, const float* TICK_Cos)
     {
         //R1.00 Most of these are from JUCE demo code. Could be reduced if not used.
-        //R1.00 Could PRECALC if they were all the same size control. 
         auto radius = (float)juce::jmin(width / 2, height / 2) - 8.0f;
         auto centreX = (float)x + (float)width * 0.5f;
         auto centreY = (float)y + (float)height * 0.5f;
         auto rx = centreX - radius;
         auto ry = centreY - radius;
         auto rw = radius * 2.0f;
-        auto angle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle); //R1.00 Bizarre values here 216(36) to 504(324).
 
         //R1.00 Mako Var defs.
         float sinA;
         float cosA;
         juce::ColourGradient ColGrad;
-        int col;
 
         //1.00 Draw the KNOB face.
         ColGrad = juce::ColourGradient(juce::Colour(0xFF808080), 0.0f, y, juce::Colour(0xFF404040), 0.0f, y + height, false);
@@ -156,7 +349,7 @@ public:
         g.drawEllipse(rx, ry, rw, rw, 1.0f);
 
         //R1.00 Dont draw anymore objects if the control is disabled.
-        if (sld.isEnabled() == false) return;
+        if (Enabled == false) return;
 
         //R1.00 Copy our predefined KNOB PATH, scale it, and then transform it to the centre position.
         //R1.00 The knob SIZE must be performed first. It is then ROTATED around its center. Then moved (TRANSLATED) to the screen knob position.
@@ -177,10 +370,8 @@ public:
         //}
 
         //R1.00 TICK marks on background.
-        //R1.00 We are cheating and using the rotarySliderOutlineColourId as a tick mark style selector.
         g.setColour(juce::Colour(0xFF000000));
-        juce::Colour C1 = sld.findColour(juce::Slider::rotarySliderOutlineColourId);
-        if (C1 == juce::Colour(0x1))
+        if (TickStyle == 0x1)
         {
             for (int t = 0; t < 11; t++)
             {
@@ -189,13 +380,13 @@ public:
                 g.drawLine(centreX + (sinA * 1.2f), centreY - (cosA * 1.2f), centreX + sinA * 1.1f, centreY - cosA * 1.1f, 1.0f);
             }
         }
-        if (C1 == juce::Colour(0x2))
+        if (TickStyle == 0x2)
         {
             sinA = TICK_Sin[0] * radius; cosA = TICK_Cos[0] * radius; g.drawLine(centreX + (sinA * 1.2f), centreY - (cosA * 1.2f), centreX + sinA * 1.1f, centreY - cosA * 1.1f, 1.0f);
             sinA = TICK_Sin[5] * radius; cosA = TICK_Cos[5] * radius; g.drawLine(centreX + (sinA * 1.2f), centreY - (cosA * 1.2f), centreX + sinA * 1.1f, centreY - cosA * 1.1f, 1.0f);
             sinA = TICK_Sin[10] * radius; cosA = TICK_Cos[10] * radius; g.drawLine(centreX + (sinA * 1.2f), centreY - (cosA * 1.2f), centreX + sinA * 1.1f, centreY - cosA * 1.1f, 1.0f);
         }
-        if (C1 == juce::Colour(0x3))
+        if (TickStyle == 0x3)
         {
             sinA = TICK_Sin[0] * radius; cosA = TICK_Cos[0] * radius; g.drawLine(centreX + (sinA * 1.2f), centreY - (cosA * 1.2f), centreX + sinA * 1.1f, centreY - cosA * 1.1f, 1.0f);
             sinA = TICK_Sin[10] * radius; cosA = TICK_Cos[10] * radius; g.drawLine(centreX + (sinA * 1.2f), centreY - (cosA * 1.2f), centreX + sinA * 1.1f, centreY - cosA * 1.1f, 1.0f);
@@ -204,9 +395,8 @@ public:
         //R1.00 Draw finger adjust dent/indicator.
         sinA = std::sinf(angle);
         cosA = std::cosf(angle);
-        g.setColour(sld.findColour(juce::Slider::thumbColourId));
+        g.setColour(Thumb);
         g.drawLine(centreX + sinA * radius * .5f, centreY - cosA * radius * .5f, centreX + sinA * radius, centreY - cosA * radius, 4.0f);
-
     }
 };
 
@@ -247,7 +437,7 @@ public:
 //*******************************************************************************************************************
 //R1.00 Add SLIDER listener. BUTTON or TIMER listeners also go here if needed. Must add ValueChanged overrides!
 //*******************************************************************************************************************
-class MakoBiteAudioProcessorEditor  : public juce::AudioProcessorEditor , public juce::Slider::Listener //, public juce::Button::Listener , public juce::Timer
+class MakoBiteAudioProcessorEditor  : public juce::AudioProcessorEditor , public juce::Slider::Listener , public juce::Timer //, public juce::Button::Listener
 {
 public:
     MakoBiteAudioProcessorEditor (MakoBiteAudioProcessor&);
@@ -255,6 +445,7 @@ public:
 
     //R1.00 OUR override functions.
     void sliderValueChanged(juce::Slider* slider) override;
+    void timerCallback() override;
 
     //==============================================================================
     void paint (juce::Graphics&) override;
@@ -272,6 +463,32 @@ private:
 
     juce::Image imgBackground;
 
+    //R1.02 Background with all of the knob text already drawn on it. Only rebuilt when the EQ names change.
+    juce::Image imgComposite;
+    float Composite_Scale = 0.0f;
+    void Mako_Build_Background(float Scale, juce::Rectangle<int> Area);
+    juce::Rectangle<int> Mako_Label_Bounds(int t) const { return { int(Knob_Pos[t].x), int(Knob_Pos[t].y) - 10, int(Knob_Pos[t].sizex), 15 }; }
+
+    //R1.02 SCOPE and SPECTRUM panel under the amp. Updated by our timer at 30 frames a second.
+    static const int Scope_Top = 180;
+    static const int Scope_Height = 110;
+    static const int Scope_FFTSize = 1024;
+    float Scope_HistIn[Scope_FFTSize] = {};       //R1.02 Last 1024 scope samples.
+    float Scope_HistOut[Scope_FFTSize] = {};
+    int Scope_HistPos = 0;
+    float Scope_TmpIn[2048] = {};
+    float Scope_TmpOut[2048] = {};
+    float Spec_In[Scope_FFTSize / 2] = {};         //R1.02 Spectrum in dB.
+    float Spec_Out[Scope_FFTSize / 2] = {};
+    float FFT_Window[Scope_FFTSize] = {};
+    float Resp_Freq[128] = {};                    //R1.02 EQ and High Cut response curve in dB.
+    float Resp_dB[128] = {};
+    int Resp_Version_Last = -1;
+    int Gov_Level_Last = 0;                        //R1.02 CPU governor level shown on the scope.
+    void Mako_Draw_Scope(juce::Graphics& g);
+    void Mako_Spectrum_Calc(const float* Hist, float* Spec);
+    bool Mako_Resp_Calc();
+
     void Mako_Init_Large_Slider(juce::Slider* slider, float Val, float Vmin, float Vmax, float Vinterval, juce::String Suffix, int TickStyle, int ThumbColor);
     void Mako_Init_Small_Slider(juce::Slider* slider, float Val, float Vmin, float Vmax, float Vinterval, juce::String Suffix);
     void Mako_Init_Small_Switch(juce::Slider* slider, float Val, juce::String Suffix);
@@ -288,7 +505,8 @@ private:
     void Mako_Knob_DefinePosition(int t, float x, float y, float sizex, float sizey, juce::String name);
 
     //R1.00 These are the indexes into our Settings var.
-    enum { e_Gain, e_NGate, e_Drive, e_Comp, e_EQ, e_EQ1, e_EQ2, e_EQ3, e_EQ4, e_EQ5, e_IR, e_Bottom, e_Mono, e_HighCut, e_Sag, e_Asym, e_LowCut };
+    enum { e_Gain, e_NGate, e_Drive, e_Comp, e_EQ, e_EQ1, e_EQ2, e_EQ3, e_EQ4, e_EQ5, e_IR, e_Bottom, e_Mono, e_HighCut, e_Sag, e_Asym, e_LowCut,
+           e_CompAtk, e_CompRel, e_CompRatio, e_CompKnee, e_CompRMS, e_CompLink };
 
 public:
     
@@ -0,0 +1,25 @@
+/*
+  ==============================================================================
+
+    The 5 IMPULSE RESPONSES (speaker cabs) built into the VST.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//********************************************************************************
+//R1.00 These are the 5 IMPULSE RESPONSES (speaker cabs) we are using.
+//R1.00 Can save these in your project as WAVE files and read them. Done here
+//R1.00 for code simplicity.
+//R1.02 They live in PluginIRs.cpp so they are stored once in read only memory
+//R1.02 and are not copied into every VST instance or recompiled with the header.
+//********************************************************************************
+extern const float IR_Stored_01[1024];
+extern const float IR_Stored_02[1024];
+extern const float IR_Stored_03[1024];
+extern const float IR_Stored_04[1024];
+extern const float IR_Stored_05[1024];
+
+extern const float* const IR_Stored_List[6];    //R1.02 Stored IRs by IR Model (0-5).
+extern const float IR_Stored_Vol[6];             //R1.02 Volume adjust for each IR Model.
@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    Worker pool shared by every Mako Rusty in the host.
+
+  ==============================================================================
+*/
+
+#include "PluginPool.h"
+#include "PluginTrace.h"      //R1.02 Markers for MAKO_TRACE builds.
+#include "PluginRTCheck.h"    //R1.02 Audio thread checks for MAKO_RTCHECK builds.
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <semaphore.h>
+ #include <ctime>
+#endif
+
+//R1.02 sem_post, dispatch_semaphore_signal and ReleaseSemaphore are an atomic add
+//R1.02 plus a kernel wake only when someone is waiting. No mutex on the signal side.
+MakoWake::MakoWake()
+{
+   #if JUCE_WINDOWS
+    Sem = CreateSemaphoreW(nullptr, 0, 0x7fffffff, nullptr);
+   #elif JUCE_MAC || JUCE_IOS
+    Sem = (void*) dispatch_semaphore_create(0);
+   #else
+    auto* S = new sem_t;
+    sem_init(S, 0, 0);
+    Sem = S;
+   #endif
+}
+
+MakoWake::~MakoWake()
+{
+   #if JUCE_WINDOWS
+    CloseHandle((HANDLE) Sem);
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_release((dispatch_semaphore_t) Sem);
+   #else
+    sem_destroy((sem_t*) Sem);
+    delete (sem_t*) Sem;
+   #endif
+}
+
+void MakoWake::Signal()
+{
+   #if JUCE_WINDOWS
+    ReleaseSemaphore((HANDLE) Sem, 1, nullptr);
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_signal((dispatch_semaphore_t) Sem);
+   #else
+    sem_post((sem_t*) Sem);
+   #endif
+}
+
+void MakoWake::Wait(int Ms)
+{
+   #if JUCE_WINDOWS
+    WaitForSingleObject((HANDLE) Sem, DWORD(Ms));
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_wait((dispatch_semaphore_t) Sem, dispatch_time(DISPATCH_TIME_NOW, juce::int64(Ms) * 1000000));
+   #else
+    timespec T;
+    clock_gettime(CLOCK_REALTIME, &T);
+    T.tv_sec += Ms / 1000;
+    T.tv_nsec += long(Ms % 1000) * 1000000L;
+    if (1000000000L <= T.tv_nsec) { T.tv_sec++; T.tv_nsec -= 1000000000L; }
+    sem_timedwait((sem_t*) Sem, &T);
+   #endif
+}
+
+//R1.02 Leave a core for the host and the audio thread. More than 8 workers just adds wake ups.
+MakoPool::MakoPool()
+{
+    Worker_Cnt = juce::jlimit(1, 8, juce::SystemStats::getNumCpus() - 1);
+    Queues.reset(new tp_queue[Worker_Cnt]);
+
+    for (int w = 0; w < Worker_Cnt; w++)
+    {
+        Workers.push_back(std::make_unique<tp_worker>(*this, w));
+        if (! Workers[w]->startRealtimeThread(juce::Thread::RealtimeOptions().withPriority(7)))
+            Workers[w]->startThread(juce::Thread::Priority::high);
+    }
+}
+
+MakoPool::~MakoPool()
+{
+    for (auto& W : Workers) W->signalThreadShouldExit();
+    for (auto& W : Workers)
+    {
+        W->Wake.Signal();
+        W->stopThread(1000);
+    }
+}
+
+bool MakoPool::Push(MakoTailJob* Job, int Hint)
+{
+    //R1.02 Try our own queue first. Someone else holding a lock is not worth waiting for.
+    for (int t = 0; t < Worker_Cnt; t++)
+    {
+        int w = (Hint + t) % Worker_Cnt;
+        auto& Q = Queues[w];
+        if (! Q.Lock.tryEnter()) continue;
+
+        bool Ok = (Q.Count < Queue_Size);
+        if (Ok)
+        {
+            Q.Jobs[(Q.First + Q.Count) % Queue_Size] = Job;
+            Q.Count++;
+            Queue_Depth.fetch_add(1);
+        }
+        Q.Lock.exit();
+
+        if (Ok)
+        {
+            if (Workers[w]->Sleeping.exchange(false)) Workers[w]->Wake.Signal();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MakoPool::Remove(void* Owner)
+{
+    for (int w = 0; w < Worker_Cnt; w++)
+    {
+        auto& Q = Queues[w];
+        const juce::SpinLock::ScopedLockType Lock(Q.Lock);
+
+        //R1.02 Keep every job that is not ours, in order.
+        int Kept = 0;
+        for (int t = 0; t < Q.Count; t++)
+        {
+            MakoTailJob* Job = Q.Jobs[(Q.First + t) % Queue_Size];
+            if (Job->Owner == Owner) continue;
+            Q.Jobs[(Q.First + Kept) % Queue_Size] = Job;
+            Kept++;
+        }
+        Queue_Depth.fetch_sub(Q.Count - Kept);
+        Q.Count = Kept;
+    }
+}
+
+//R1.02 Front of our own queue, else steal from the back of someone elses.
+//R1.02 The job is marked Running while we hold the lock, so once Remove has been thru
+//R1.02 every queue no worker can be holding a job it has not claimed.
+MakoTailJob* MakoPool::Pop(int Worker)
+{
+    for (int t = 0; t < Worker_Cnt; t++)
+    {
+        auto& Q = Queues[(Worker + t) % Worker_Cnt];
+        const juce::SpinLock::ScopedLockType Lock(Q.Lock);
+
+        while (0 < Q.Count)
+        {
+            MakoTailJob* Job;
+            if (t == 0)
+            {
+                Job = Q.Jobs[Q.First];
+                Q.First = (Q.First + 1) % Queue_Size;
+            }
+            else
+                Job = Q.Jobs[(Q.First + Q.Count - 1) % Queue_Size];
+
+            Q.Count--;
+            Queue_Depth.fetch_sub(1);
+
+            //R1.02 Skip jobs the owner has already given up on.
+            int Expect = MakoTailJob::e_Queued;
+            if (Job->State.compare_exchange_strong(Expect, MakoTailJob::e_Running)) return Job;
+        }
+    }
+
+    return nullptr;
+}
+
+//R1.02 Tail taps Head to 1023. In[] is newest first, so for output i, x[n - k] is In[k - i - 1].
+void MakoPool::Run(MakoTailJob* Job)
+{
+    const float* IR = Job->IR;
+    for (int i = 0; i < Job->Len; i++)
+    {
+        const float* X = Job->In - i - 1;
+        float V = 0.0f;
+        for (int k = Job->Head; k < 1024; k++) V += IR[k] * X[k];
+        Job->Out[i] = V;
+    }
+}
+
+void MakoPool::tp_worker::run()
+{
+    juce::ScopedNoDenormals noDenormals;
+    MAKO_TRACE_THREAD("Mako Pool");
+
+    while (! threadShouldExit())
+    {
+        MakoTailJob* Job = Pool.Pop(Index);
+        if (Job == nullptr)
+        {
+            //R1.02 Nothing to do. Check once more after saying we are asleep so a push is never missed.
+            //R1.02 Push clears Sleeping when it signals, so a burst of jobs posts once.
+            Sleeping.store(true);
+            Job = Pool.Pop(Index);
+            if (Job == nullptr) Wake.Wait(100);
+            Sleeping.store(false);
+            if (Job == nullptr) continue;
+        }
+
+        //R1.02 Already too late to help.
+        if (Job->Deadline < juce::Time::getMillisecondCounterHiRes())
+        {
+            Job->State.store(MakoTailJob::e_Cancelled, std::memory_order_release);
+            continue;
+        }
+
+        {
+            MAKO_TRACE_SCOPE("Cab Tail");
+            MAKO_RT_SCOPE();
+            Run(Job);
+        }
+        Job->State.store(MakoTailJob::e_Done, std::memory_order_release);
+    }
+}
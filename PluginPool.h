@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    Worker pool shared by every Mako Rusty in the host.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//R1.02 Wakes a sleeping thread. Signal takes no lock, so the audio thread may call it.
+//R1.02 juce::WaitableEvent::signal locks a mutex. This is a counting semaphore instead.
+class MakoWake
+{
+public:
+    MakoWake();
+    ~MakoWake();
+
+    void Signal();                  //R1.02 Any thread. Never blocks.
+    void Wait(int Ms);              //R1.02 Sleep until signaled or Ms pass. Callers must recheck, it can return early.
+
+private:
+    void* Sem = nullptr;            //R1.02 sem_t, dispatch_semaphore_t or a Windows HANDLE.
+
+    JUCE_DECLARE_NON_COPYABLE(MakoWake)
+};
+
+//********************************************************************************
+//R1.02 The cab IR is split in two. The first Head taps are done on the audio thread.
+//R1.02 The rest (the tail) only needs input we already have, so it is done one
+//R1.02 block early by the pool. If it is not Done when the block needs it, the
+//R1.02 audio thread does the whole IR itself.
+//********************************************************************************
+struct MakoTailJob {
+    enum { e_Idle, e_Queued, e_Running, e_Done, e_Cancelled };
+
+    std::atomic<int> State { e_Idle };
+    void* Owner = nullptr;          //R1.02 Processor that owns this job.
+    double Deadline = 0.0;          //R1.02 Time::getMillisecondCounterHiRes() when the result is needed.
+    const float* IR = nullptr;
+    int Head = 0;                   //R1.02 First tap in the tail.
+    int Len = 0;                    //R1.02 Output samples to calc. Never more than Head.
+    juce::int64 Seq = -1;           //R1.02 Sample position of the block this result is for.
+    float In[1024];                 //R1.02 The last 1024 cab input samples, newest first.
+    float Out[512];
+};
+
+//R1.02 One per process thru juce::SharedResourcePointer. Each worker has its own queue
+//R1.02 and steals from the back of the others, like the sweep tool.
+class MakoPool
+{
+public:
+    MakoPool();
+    ~MakoPool();
+
+    //R1.02 Audio thread. Never blocks. Returns false if the job could not be queued. Hint must not be negative.
+    bool Push(MakoTailJob* Job, int Hint);
+
+    //R1.02 Take every job for Owner off the queues. Blocks, call from the processor destructor.
+    void Remove(void* Owner);
+
+    std::atomic<int> Queue_Depth { 0 };         //R1.02 Jobs waiting to be picked up.
+    std::atomic<int> Deadline_Misses { 0 };     //R1.02 Results that were not ready in time, all instances.
+
+    static const int Head_Max = 512;
+
+private:
+    static const int Queue_Size = 256;
+
+    struct tp_queue {
+        juce::SpinLock Lock;
+        MakoTailJob* Jobs[Queue_Size];
+        int First = 0;
+        int Count = 0;
+    };
+
+    class tp_worker : public juce::Thread
+    {
+    public:
+        tp_worker(MakoPool& p, int idx) : juce::Thread("Mako Rusty Pool"), Pool(p), Index(idx) {}
+        void run() override;
+
+        MakoPool& Pool;
+        int Index;
+        std::atomic<bool> Sleeping { false };
+        MakoWake Wake;
+    };
+
+    int Worker_Cnt = 0;
+    std::unique_ptr<tp_queue[]> Queues;
+    std::vector<std::unique_ptr<tp_worker>> Workers;
+
+    MakoTailJob* Pop(int Worker);
+    static void Run(MakoTailJob* Job);
+
+    JUCE_DECLARE_NON_COPYABLE(MakoPool)
+};
@@ -8,7 +8,14 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "PluginTrace.h"      //R1.02 Markers for MAKO_TRACE builds.
+#include "PluginRTCheck.h"    //R1.02 Audio thread checks for MAKO_RTCHECK builds.
 #include "cmath"              //R1.00 Added library.
+#include <complex>            //R1.02 Eco cab fit.
+
+#if MAKO_LOCK_ARENA && (JUCE_LINUX || JUCE_MAC || JUCE_BSD)
+ #include <sys/mman.h>        //R1.02 mlock for the state arena.
+#endif
 
 //==============================================================================
 MakoBiteAudioProcessor::MakoBiteAudioProcessor()
@@ -42,15 +49,96 @@ MakoBiteAudioProcessor::MakoBiteAudioProcessor()
         std::make_unique<juce::AudioParameterFloat>("sag","Sag", 0.0f, .8f, .0f),             //R1.01 Added.
         std::make_unique<juce::AudioParameterFloat>("asym","Asym", 0.0f, .8f, 0.0f),         //R1.01 Added.
         std::make_unique<juce::AudioParameterFloat>("lowcut","Low Cut", 0.0f, 1.0f, 1.0f),    //R1.01 Added.
+        std::make_unique<juce::AudioParameterFloat>("compatk","Comp Attack mS", 0.1f, 100.0f, 3.0f),     //R1.02 Added.
+        std::make_unique<juce::AudioParameterFloat>("comprel","Comp Release mS", 10.0f, 1000.0f, 60.0f), //R1.02 Added.
+        std::make_unique<juce::AudioParameterFloat>("compratio","Comp Ratio", 1.0f, 20.0f, 2.5f),        //R1.02 Added.
+        std::make_unique<juce::AudioParameterFloat>("compknee","Comp Knee dB", 0.0f, 24.0f, 6.0f),       //R1.02 Added.
+        std::make_unique<juce::AudioParameterInt>("comprms","Comp RMS", 0, 1, 0),                        //R1.02 Added.
+        std::make_unique<juce::AudioParameterInt>("complink","Comp Link", 0, 1, 1),                      //R1.02 Added.
+        std::make_unique<juce::AudioParameterInt>("multicore","Multi Core", 0, 1, 0),                    //R1.02 Added.
+        std::make_unique<juce::AudioParameterInt>("cabpool","Cab Pool", 0, 1, 0),                        //R1.02 Added.
+        std::make_unique<juce::AudioParameterInt>("ir2","IR 2 Model", 0, 5, 0),                         //R1.02 Added.
+        std::make_unique<juce::AudioParameterFloat>("irmix","IR Mix", 0.0f, 1.0f, 0.0f),                //R1.02 Added.
+        std::make_unique<juce::AudioParameterInt>("eco","Eco Cab", 0, 1, 0),                            //R1.02 Added.
+        std::make_unique<juce::AudioParameterInt>("offline","Offline HQ", 0, 3, 2),                     //R1.02 Added. Off, 2x, 4x, 8x.
+        std::make_unique<juce::AudioParameterInt>("governor","CPU Governor", 0, 1, 1),                  //R1.02 Added.
+        std::make_unique<juce::AudioParameterInt>("adaa","Anti Alias", 0, 1, 0),                        //R1.02 Added.
+        std::make_unique<juce::AudioParameterInt>("svf","Smooth Filters", 0, 1, 0),                     //R1.02 Added.
       }
     )   
 
 #endif
 {   
+    //R1.02 Find our parameter values once. Searching by name creates juce::Strings every time.
+    for (int t = 0; t < Parm_Cnt; t++)
+    {
+        Parm_Value[t] = parameters.getRawParameterValue(Parm_IDs[t]);
+        Parm_Object[t] = parameters.getParameter(Parm_IDs[t]);
+    }
+
+    //R1.02 Control rate stages.
+    Mako_Ctrl_Register(e_CtrlPre, "Noise Gate", &MakoBiteAudioProcessor::Mako_Gate_Tick, &MakoBiteAudioProcessor::Mako_Gate_On);
+    Mako_Ctrl_Register(e_CtrlPost, "Compressor", &MakoBiteAudioProcessor::Mako_Comp_Tick, &MakoBiteAudioProcessor::Mako_Comp_On);
+
+    //R1.02 Watch for preset switches made by the audio thread.
+    startTimerHz(20);
 }
 
+//R1.02 Parameter IDs in Setting[] index order (e_Gain, e_NGate, etc).
+//R1.02 This is also the order of the saved binary state. Never reorder, only add to the end.
+const char* const MakoBiteAudioProcessor::Parm_IDs[] = { "gain", "ngate", "drive", "comp", "eq", "eq1", "eq2", "eq3", "eq4", "eq5", "ir", "bottom", "mono", "highcut", "sag", "asym", "lowcut",
+                                                            "compatk", "comprel", "compratio", "compknee", "comprms", "complink", "multicore", "cabpool", "ir2", "irmix", "eco", "offline", "governor", "adaa", "svf" };
+
+//R1.02 CPU governor levels, best first. IR taps and tanh tier.
+const MakoBiteAudioProcessor::tp_govlevel MakoBiteAudioProcessor::Gov_Table[Gov_Levels] = { { 1024, false }, { 512, false }, { 256, false }, { 256, true }, { 128, true } };
+
+//R1.02 Preset bank. Knob values in Setting[] order:
+//R1.02 Gain, NGate, Drive, Comp, EQ, EQ1-EQ5, IR, Bottom, Mono, HighCut, Sag, Asym, LowCut.
+const char* const MakoBiteAudioProcessor::Preset_Names[Preset_Cnt] = { "Default", "Clean Jingle", "Edge of Breakup", "Crunch", "Bright Lead", "Dark Blues", "Bass Thru", "Sag Crunch" };
+
+const float MakoBiteAudioProcessor::Preset_Values[Preset_Cnt][17] = {
+    { .40f, .00f, .10f, 1.0f,  0,   .0f,  .0f,  .0f,  .0f,  .0f, 1, .50f, 1, 2500, .00f, .00f, 1 },
+    { .55f, .00f, .05f, .60f,  1,  -2.0f, .0f, 1.5f, 2.0f, 3.0f, 2, .35f, 1, 5000, .00f, .00f, 1 },
+    { .45f, .10f, .30f, .80f,  4,   1.0f, .0f,-1.0f, 2.0f, 1.0f, 3, .50f, 1, 4200, .10f, .10f, 1 },
+    { .35f, .30f, .55f, 1.0f,  3,   2.0f,-1.0f,-3.0f, 3.0f, 2.0f, 1, .60f, 1, 3600, .20f, .20f, 1 },
+    { .30f, .40f, .85f, .70f,  6,   .0f,  2.0f, 1.0f, 4.0f, 2.0f, 4, .45f, 1, 4600, .10f, .30f, 1 },
+    { .40f, .20f, .45f, .90f,  5,   3.0f, 2.0f,-2.0f,-3.0f,-4.0f, 5, .70f, 1, 2600, .30f, .00f, 1 },
+    { .50f, .00f, .20f, .50f,  2,   4.0f, 2.0f,-2.0f, .0f, -3.0f, 0, .80f, 1, 3000, .00f, .00f, 0 },
+    { .35f, .30f, .65f, 1.0f,  7,   1.0f, .0f,  2.0f, 1.0f, .0f,  1, .55f, 1, 3200, .60f, .20f, 1 },
+};
+
 MakoBiteAudioProcessor::~MakoBiteAudioProcessor()
 {
+    stopTimer();
+
+    //R1.02 Our worker and kernel builder use this processor, stop them first.
+    if (Worker != nullptr)
+    {
+        Worker->signalThreadShouldExit();
+        Worker->Wake.Signal();
+        Worker->stopThread(1000);
+    }
+    if (Builder != nullptr)
+    {
+        Builder->signalThreadShouldExit();
+        Builder->Wake.Signal();
+        Builder->stopThread(1000);
+    }
+
+    //R1.02 Take our cab jobs out of the shared pool and wait for any being worked on.
+    if (auto* P = Pool.load()) P->Remove(this);
+    for (int c = 0; c < 2; c++)
+        for (int ch = 0; ch < 2; ch++)
+            while (Tail_Jobs[c][ch].State.load() == MakoTailJob::e_Running) juce::Thread::sleep(1);
+
+   #if MAKO_LOCK_ARENA && (JUCE_LINUX || JUCE_MAC || JUCE_BSD)
+    if (Arena_Locked) munlock(Arena.get(), sizeof(tp_arena));
+   #endif
+
+   #if MAKO_TRACE
+    //R1.02 The rings are shared by every instance, so the last one closed writes the most complete file.
+    MakoTrace::Export(juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("MakoRustyTrace.json"));
+   #endif
 }
 
 //==============================================================================
@@ -93,31 +181,92 @@ double MakoBiteAudioProcessor::getTailLengthSeconds() const
 
 int MakoBiteAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    return Preset_Cnt;   //R1.02 Our preset bank.
 }
 
+//R1.02 A preset asked for but not switched to yet counts as current, so the host sees its own change at once.
 int MakoBiteAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    int Pending = Preset_Pending.load();
+    return (0 <= Pending) ? Pending : Preset_Current.load();
 }
 
+//R1.02 Host changed the preset. The audio thread does the switch and our timer shows the new knob values.
 void MakoBiteAudioProcessor::setCurrentProgram (int index)
 {
+    if ((index < 0) || (Preset_Cnt <= index)) return;
+
+    Preset_Pending.store(index);
 }
 
 const juce::String MakoBiteAudioProcessor::getProgramName (int index)
 {
-    return {};
+    if ((index < 0) || (Preset_Cnt <= index)) return {};
+    return Preset_Names[index];
 }
 
 void MakoBiteAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
 }
 
+//R1.02 Push the current preset to the parameters so the host and editor knobs follow it.
+//R1.02 The editor flags a settings update, but Mako_Settings_Update sees the chain already has
+//R1.02 these values and does not redesign anything.
+void MakoBiteAudioProcessor::Mako_Preset_Follow()
+{
+    int Switches = Preset_Switches.load(std::memory_order_acquire);
+    if (Switches == Preset_Shown) return;
+    Preset_Shown = Switches;
+
+    const float* Values = Preset_Values[Preset_Current.load()];
+    for (int t = 0; t < Parm_Knob_Cnt; t++)
+    {
+        if (Parm_Object[t] != nullptr) Parm_Object[t]->setValueNotifyingHost(Parm_Object[t]->convertTo0to1(Values[t]));
+    }
+}
+
+void MakoBiteAudioProcessor::Mako_Threads_Follow()
+{
+    //R1.02 Join the shared cab pool. Its workers start with the first instance that joins.
+    if ((Pool_Ref == nullptr) && (.5f < Parm_Value[e_CabPool]->load()))
+    {
+        Pool_Ref = std::make_unique<juce::SharedResourcePointer<MakoPool>>();
+        Pool.store(&Pool_Ref->get(), std::memory_order_release);
+    }
+
+    //R1.02 Start our channel worker the first time Multi Core is on. Without realtime priority it could
+    //R1.02 be held off past the block deadline, so then we leave the split off and process both channels here.
+    if (! Worker_Tried && (.5f < Parm_Value[e_MultiCore]->load()) && (1 < getTotalNumInputChannels()))
+    {
+        Worker_Tried = true;
+        Worker = std::make_unique<tp_worker>(*this);
+        if (Worker->startRealtimeThread(juce::Thread::RealtimeOptions().withPriority(8)))
+            Worker_Ready.store(Worker.get(), std::memory_order_release);
+        else
+            Worker.reset();
+    }
+
+    //R1.02 Start our blend kernel builder the first time IR 2 and IR Mix are both up, then
+    //R1.02 wake it when the audio thread has posted a kernel to build.
+    if ((Builder == nullptr) && (0.0f < Parm_Value[e_IR2]->load()) && (0.0f < Parm_Value[e_IRMix]->load()))
+    {
+        Builder = std::make_unique<tp_builder>(*this);
+        Builder->startThread(juce::Thread::Priority::low);
+    }
+    if ((Builder != nullptr) && (0 <= Blend_Request.load())) Builder->Wake.Signal();
+
+    //R1.02 Fit the eco cab to every IR the first time eco is on. The audio thread keeps the full IR until then.
+    if (! Eco_Ready.load() && (.5f < Parm_Value[e_Eco]->load()))
+    {
+        Mako_Eco_Fit();
+        Eco_Ready.store(true, std::memory_order_release);
+    }
+}
+
 //==============================================================================
 void MakoBiteAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    MAKO_TRACE_SCOPE("prepareToPlay");
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
 
@@ -125,6 +274,7 @@ void MakoBiteAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     SampleRate = MakoBiteAudioProcessor::getSampleRate();
     if (SampleRate < 21000) SampleRate = 48000;
     if (192000 < SampleRate) SampleRate = 48000;
+    Scope_SampleRate = SampleRate * .5f;
 
     //R1.00 Calculate some rough decay subtraction values for peak tracking (compress,autowah,etc). 
     Release_100mS = (1.0f / .100f) * (1.0f / SampleRate);
@@ -133,23 +283,48 @@ void MakoBiteAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     Release_400mS = (1.0f / .400f) * (1.0f / SampleRate); 
     Release_500mS = (1.0f / .500f) * (1.0f / SampleRate); 
 
-    //R1.00 Calculate the fixed value filters.
-    //Filter_BP_Coeffs(12.0f, 150.0f, 1.414, &makoF_ChimeraLow);     
-    Filter_LP_Coeffs(150.0f, &makoF_ChimeraLow);
-    Filter_HP_Coeffs(1500.0f, &makoF_ChimeraHigh);
-    Filter_HP_Coeffs(80.0f, &makoF_HighPass);
+    //R1.02 Noise gate times. 4mS envelope, 1mS open, 50mS hold, 100mS close.
+    Gate_EnvCoef = expf(-1.0f / (.004f * SampleRate));
+    Gate_AttackStep = 1.0f / (.001f * SampleRate);
+    Gate_ReleaseStep = 1.0f / (.100f * SampleRate);
+    Gate_HoldSamples = int(.050f * SampleRate);
+    for (int n = 0; n <= Ctrl_Max; n++) Gate_EnvPow[n] = powf(Gate_EnvCoef, float(n));
+
+    //R1.02 Compressor attack and release for our control rate.
+    Mako_Comp_SetTimes();
+
+    //R1.02 Design the realtime and offline profiles, then play the one the host wants.
+    Mako_Profile_Design(&Arena->Profiles[0], false);
+    Mako_Profile_Design(&Arena->Profiles[1], true);
+    //R1.02 Hosts call setNonRealtime before prepareToPlay when a bounce starts, so the latency is right for it.
+    Profile_Want.store(isNonRealtime() ? 1 : 0);
+    Mako_Profile_Use(Profile_Want.load());
+    if (getLatencySamples() != Profile->Latency) setLatencySamples(Profile->Latency);
+
+    //R1.02 20mS equal power crossfade. Out = New * Fade[i] + Old * Fade[Len - 1 - i].
+    Preset_FadeLen = juce::jmax(1, int(.020f * SampleRate));
+    Preset_Fade.resize(Preset_FadeLen);
+    for (int t = 0; t < Preset_FadeLen; t++) Preset_Fade[t] = sinf(.5f * pi * (float(t) + .5f) / float(Preset_FadeLen));
+
+    //R1.02 The audio thread state is in RAM before the first block.
+    Mako_Arena_Prepare();
+
+    //R1.02 Start from silence so a reused processor sounds the same every time.
+    Mako_Reset_State();
+
+    //R1.02 A new sample rate needs a new eco fit. Mako_Threads_Follow does it once eco is on.
+    Eco_Ready.store(Eco_FitRate == SampleRate);
+
+    //R1.02 Cab taps past Tail_Head go to the pool. Blocks longer than this do the whole IR here.
+    Tail_Head = juce::jlimit(64, MakoPool::Head_Max, juce::nextPowerOfTwo(samplesPerBlock));
+    Mako_Threads_Follow();
 
     //R1.00 Update the adjustable values and filters. 
     Mako_Band_SetFilterValues();
     Mako_Settings_Update(true);
 
-    //R1.00 Create our initial IR and set a volume factor for each stored IR.  
-    IR_VolAdjustVals[1] = .29f;
-    IR_VolAdjustVals[2] = .26f;
-    IR_VolAdjustVals[3] = .25f;
-    IR_VolAdjustVals[4] = .21f;
-    IR_VolAdjustVals[5] = .25f;
-    Mako_IR_Set();
+    //R1.00 Create our initial IR.
+    Mako_IR_Set(true);
 
 }
 
@@ -186,17 +361,111 @@ bool MakoBiteAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 #endif
 
 void MakoBiteAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    Mako_Process(buffer, midiMessages);
+}
+
+//R1.02 64 bit hosts give us doubles. Same code, no conversion.
+void MakoBiteAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    Mako_Process(buffer, midiMessages);
+}
+
+bool MakoBiteAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+//R1.02 Our processBlock for both sample types.
+template <typename T>
+void MakoBiteAudioProcessor::Mako_Process(juce::AudioBuffer<T>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    MAKO_TRACE_THREAD("Audio");
+    MAKO_TRACE_SCOPE("processBlock");
+    MAKO_RT_SCOPE();
+    auto Gov_Start = juce::Time::getHighResolutionTicks();
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
-    //R1.00 Our defined variables.
-    float tS;  //R1.00 Temporary Sample.
+    //R1.02 Parameters without a knob are read straight from the host.
+    for (int t = Parm_Knob_Cnt; t < Parm_Cnt; t++) Setting[t] = Parm_Value[t]->load();
+
+    //R1.02 OFFLINE HQ - Follow the host in and out of bounces. The profile is already designed, so this
+    //R1.02 is a swap. A preset fade finishes first so both chains are always at the same amp rate.
+    //R1.02 The offline profile is claimed first. If the message thread is redesigning it, try next block.
+    int Want = Profile_Want.load(std::memory_order_acquire);
+    if ((Profile != &Arena->Profiles[Want]) && (Chain_Old == nullptr))
+    {
+        int Free = e_OwnerFree;
+        if ((Want == 0) || Offline_Owner.compare_exchange_strong(Free, e_OwnerAudio))
+        {
+            Mako_Profile_Use(Want);
+            Mako_Settings_Update(false);
+        }
+    }
+    if ((Setting[e_CompAtk] != Setting_Last[e_CompAtk]) || (Setting[e_CompRel] != Setting_Last[e_CompRel])) Mako_Comp_SetTimes();
+
+    //R1.02 MIDI program changes pick a preset.
+    for (const auto Msg : midiMessages)
+    {
+        auto Midi = Msg.getMessage();
+        if (Midi.isProgramChange() && (Midi.getProgramChangeNumber() < Preset_Cnt)) Preset_Pending.store(Midi.getProgramChangeNumber());
+    }
+
+    //R1.02 Start a preset change. We wait for any fade in progress to finish.
+    if ((Chain_Old == nullptr) && (0 <= Preset_Pending.load(std::memory_order_relaxed))) Mako_Preset_Switch(Preset_Pending.exchange(-1));
 
     //R1.00 Handle any changes to our Parameters made in the editor/DAW.
     if (0 < SettingsChanged) Mako_Settings_Update(false);
 
+    //R1.02 IR blend. Ask for a new kernel when ir2 or irmix move, and fade to it once it is built.
+    if ((Setting[e_IR2] != Blend_Last[0]) || (Setting[e_IRMix] != Blend_Last[1])) Mako_IR_Set(false);
+    Mako_Blend_Poll(false);
+
+    //R1.02 ADAA. Start each shaper from 0, where its input and antiderivative agree.
+    bool ADAA_Now = (.5f < Setting[e_ADAA]);
+    if (ADAA_Now && ! ADAA)
+    {
+        Mako_State_All([](auto& S, int) { for (int a = 0; a < 4; a++) S.ADAA_X[a] = S.ADAA_F[a] = 0.0; });
+    }
+    ADAA = ADAA_Now;
+
+    //R1.02 SVF. Changing filter type, start the new filters from silence.
+    bool SVF_Now = (.5f < Setting[e_SVF]);
+    if (SVF_Now != SVF)
+    {
+        Mako_State_All([SVF_Now](auto& S, int)
+        {
+            if (SVF_Now)
+            {
+                for (auto& B : S.SVF_Band) B = {};
+                S.SVF_HighCut = S.SVF_HighPass = {};
+            }
+            else
+            {
+                for (auto& B : S.Band) B = {};
+                S.HighCut = S.HighPass = {};
+            }
+        });
+    }
+    SVF = SVF_Now;
+
+    //R1.02 Eco cab. Load the fitted filters for the IR. Coming back to the full IR, clear its
+    //R1.02 buffers since they stopped being filled while eco was on. Bounces always use the full IR.
+    Eco = (.5f < Setting[e_Eco]) && ! NonRealtime && Eco_Ready.load(std::memory_order_acquire);
+    if (Eco)
+    {
+        Mako_Eco_Load(Chain);
+        if (Chain_Old != nullptr) Mako_Eco_Load(Chain_Old);
+    }
+    else if (Eco_Last)
+    {
+        Mako_State_All([](auto& S, int) { juce::FloatVectorOperations::clear(S.IRB, 1025); });
+        Arena->Chain_A.Eco_Model = Arena->Chain_B.Eco_Model = -1;
+    }
+    Eco_Last = Eco;
+
     // In case we have more outputs than inputs, this code clears any output
     // channels that didn't contain input data, (because these aren't
     // guaranteed to be empty - they may contain garbage).
@@ -212,46 +481,238 @@ void MakoBiteAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     // the samples and the outer loop is handling the channels.
     // Alternatively, you can process the samples with the channels
     // interleaved by keeping the same state.
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+    //R1.02 In MONO we only process channel 0 and copy it when we are done.
+    int numSamples = buffer.getNumSamples();
+    int numChannels = juce::jmin(int(totalNumInputChannels), 2);
+
+    //R1.02 Feed the editor scope. Nothing is done if no editor is looking.
+    bool Scope = Scope_Active.load(std::memory_order_relaxed) && (0 < numChannels);
+    if (Scope) Mako_Scope_Push(Scope_FifoIn, Scope_DataIn, buffer.getReadPointer(0), numSamples);
+
+    bool Mono = (0.1f < Setting[e_Mono]);
+    int numProcess = Mono ? juce::jmin(numChannels, 1) : numChannels;
+
+    //R1.02 MULTI CORE - Hand channel 1 to our worker and do channel 0 here.
+    tp_worker* W = Worker_Ready.load(std::memory_order_acquire);
+    bool Split = (W != nullptr) && (.5f < Setting[e_MultiCore]) && (numProcess == 2) && (Worker_MinSamples <= numSamples);
+    if (Split)
+    {
+        if constexpr (std::is_same<T, double>::value) { W->Job_Data_d = buffer.getWritePointer(1); W->Job_Data = nullptr; }
+        else { W->Job_Data = buffer.getWritePointer(1); W->Job_Data_d = nullptr; }
+        W->Job_Samples = numSamples;
+        int Job = W->Job_Posted.fetch_add(1) + 1;
+        if (W->Sleeping.exchange(false)) W->Wake.Signal();
+
+        auto Deadline = juce::Time::getHighResolutionTicks()
+                      + juce::int64(Worker_WaitFrac * numSamples / SampleRate * double(juce::Time::getHighResolutionTicksPerSecond()));
+
+        Mako_Process_Channel(buffer.getWritePointer(0), 0, numSamples);
+
+        //R1.02 Channel 1 is usually close behind. Never sleep here, just wait for it.
+        //R1.02 If the worker has not started it by the deadline, take the job back and do it here.
+        MAKO_TRACE_SCOPE("Worker Wait");
+        while (W->Job_Done.load(std::memory_order_acquire) != Job)
+        {
+            if (juce::Time::getHighResolutionTicks() < Deadline) { juce::Thread::yield(); continue; }
+
+            int Prev = Job - 1;
+            if (W->Job_Claimed.compare_exchange_strong(Prev, Job))
+            {
+                Mako_Process_Channel(buffer.getWritePointer(1), 1, numSamples);
+                W->Job_Done.store(Job, std::memory_order_release);
+                break;
+            }
+
+            //R1.02 The worker has it, so it is running right now.
+            while (W->Job_Done.load(std::memory_order_acquire) != Job) juce::Thread::yield();
+        }
+    }
+    else
+    {
+        for (int channel = 0; channel < numProcess; ++channel) Mako_Process_Channel(buffer.getWritePointer(channel), channel, numSamples);
+    }
+
+    //R1.02 Same for a change of IR inside a chain.
+    tp_chain* Chains[2] = { Chain, Chain_Old };
+    for (auto* C : Chains)
     {
-        auto* channelData = buffer.getWritePointer (channel);
+        if ((C == nullptr) || (C->IR_Old == nullptr)) continue;
+        C->IR_FadePos += numSamples;
+        if (Preset_FadeLen <= C->IR_FadePos) C->IR_Old = nullptr;
+    }
 
-        //R1.00 Process the AUDIO buffer data.
-        if ((0.1f < Setting[e_Mono]) && (channel == 1))
+    //R1.02 And for the governor fading the end of the IR in or out.
+    if (Cab_Keep != Cab_Taps)
+    {
+        Cab_FadePos += numSamples;
+        if (Preset_FadeLen <= Cab_FadePos)
         {
-            auto* channel0Data = buffer.getWritePointer(0);
+            if (Cab_Fade1 == 0.0f) Cab_Taps = Cab_Keep;
+            else Cab_Keep = Cab_Taps;
+        }
+    }
+
+    //R1.02 Every channel used the same fade position. Drop the old chain once it is faded out.
+    if (Chain_Old != nullptr)
+    {
+        Preset_FadePos += numSamples;
+        if (Preset_FadeLen <= Preset_FadePos) Chain_Old = nullptr;
+    }
+
+    //R1.02 Compressor, and anything else registered after the cab. Works on all channels at once so they can share one gain.
+    //R1.02 Skipped when every channel took the gate's silent path. The block is all zeros, so its gain just holds.
+    bool Silent = true;
+    for (int channel = 0; channel < numProcess; ++channel)
+        if (Arena->Dyn[channel].Gate_Silent - numSamples < Gate_TailSamples) Silent = false;
+    if (! Silent)
+    {
+        MAKO_TRACE_SCOPE("Control Post");
+        Mako_Ctrl_Run(e_CtrlPost, buffer.getArrayOfWritePointers(), 0, numProcess, numSamples);
+    }
+
+    //R1.00 FORCE MONO - Put CHANNEL 0 data in CHANNEL 1.
+    if (Mono && (1 < numChannels)) buffer.copyFrom(1, 0, buffer, 0, 0, numSamples);
+
+    if (Scope) Mako_Scope_Push(Scope_FifoOut, Scope_DataOut, buffer.getReadPointer(0), numSamples);
+
+    //R1.02 How much of this block's deadline did we use.
+    Mako_Gov_Update(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - Gov_Start), numSamples);
+}
+
+//R1.02 Gate, amp and cab for one channel. Called by the audio thread or our worker.
+//R1.02 Only touches state indexed by channel, so both channels can run at the same time.
+template <typename T>
+void MakoBiteAudioProcessor::Mako_Process_Channel(T* channelData, int channel, int numSamples)
+{
+    T tS;  //R1.00 Temporary Sample.
+    MAKO_TRACE_SCOPE((channel == 0) ? "Channel 0" : "Channel 1");
+
+    //R1.02 Noise gate and anything else registered before the amp. Done on the whole block so we know when it is fully closed.
+    bool GateShut;
+    {
+        MAKO_TRACE_SCOPE("Control Pre");
+        T* Chans[1] = { channelData };
+        GateShut = Mako_Ctrl_Run(e_CtrlPre, Chans, channel, 1, numSamples);
+    }
+
+    //R1.02 Once the amp and cab have had time to go quiet, there is nothing to calc.
+    tp_dyn& D = Arena->Dyn[channel];
+    if (GateShut)
+        D.Gate_Silent = juce::jmin(D.Gate_Silent + numSamples, 0x3FFFFFFF);
+    else
+        D.Gate_Silent = 0;
+
+    if (Gate_TailSamples <= D.Gate_Silent - numSamples)
+    {
+        juce::FloatVectorOperations::clear(channelData, numSamples);
+        Mako_Tail_Advance<T>(channel, numSamples);
+        return;
+    }
+
+    //R1.02 Pick up the cab tails the pool did for this block.
+    bool Fading = (Chain_Old != nullptr) && (Preset_FadePos < Preset_FadeLen);
+    if (! Eco && (0.0f < Chain->Set[e_IR])) Mako_Tail_Begin<T>(Chain, channel, numSamples);
+    if (! Eco && Fading && (0.0f < Chain_Old->Set[e_IR])) Mako_Tail_Begin<T>(Chain_Old, channel, numSamples);
+
+    //R1.00 Process the AUDIO buffer data.
+    MAKO_TRACE_SCOPE("Amp Cab");
+    int FadePos = Preset_FadePos;
+    tp_state<T>* S = Mako_State<T>(Chain, channel);
+    tp_state<T>* S_Old = Fading ? Mako_State<T>(Chain_Old, channel) : nullptr;
+    for (int samp = 0; samp < numSamples; samp++)
+    {
+        //R1.00 Get the current sample and put it in tS. 
+        tS = channelData[samp];
 
-            //R1.00 FORCE MONO - Put CHANNEL 0 data in CHANNEL 1.
-            for (int samp = 0; samp < buffer.getNumSamples(); samp++) channelData[samp] = channel0Data[samp];
+        //R1.02 While changing presets, run the old chain too and crossfade to the new one.
+        if ((Chain_Old != nullptr) && (FadePos < Preset_FadeLen))
+        {
+            T tOld = Mako_Chain_Process(tS, channel, Chain_Old, S_Old, samp);
+            tS = Mako_Chain_Process(tS, channel, Chain, S, samp);
+            tS = (tS * Preset_Fade[FadePos]) + (tOld * Preset_Fade[Preset_FadeLen - 1 - FadePos]);
+            FadePos++;
         }
         else
+            tS = Mako_Chain_Process(tS, channel, Chain, S, samp);
+
+        //R1.00 Write our modified sample back into the sample buffer.
+        channelData[samp] = tS;
+    }
+
+    //R1.02 Send the next block's cab tail to the pool. The old chain is going away so it is not sent.
+    Mako_Tail_Advance<T>(channel, numSamples);
+    if (! Eco && (Cab_Keep == 1024) && (0.0f < Chain->Set[e_IR])) Mako_Tail_Post<T>(Chain, channel, numSamples);
+}
+
+//R1.02 Worker loop. Spin while blocks are coming, sleep when they stop.
+void MakoBiteAudioProcessor::tp_worker::run()
+{
+    juce::ScopedNoDenormals noDenormals;
+    MAKO_TRACE_THREAD("Mako Worker");
+    int Seen = Job_Posted.load();
+
+    while (! threadShouldExit())
+    {
+        int Spins = 0;
+        while (Job_Posted.load(std::memory_order_acquire) == Seen)
         {
-            // ..do something to the data...
-            for (int samp = 0; samp < buffer.getNumSamples(); samp++)
-            {
-                //R1.00 Get the current sample and put it in tS. 
-                tS = buffer.getSample(channel, samp);
-
-                //R1.00 Noise gate.
-                if (0.0f < Setting[e_NGate]) tS = Mako_FX_NoiseGate(tS, channel);
-                                
-                //R1.00 Apply our Distortion to the sample. 
-                tS = Mako_FX_AmpSim(tS, channel);
-                
-                //R1.00 Impulse Response (IR).
-                if (0.0f < Setting[e_IR]) tS = Mako_CabSim(tS, channel);
-                
-                //R1.00 Compressor. Could be here or before the Amp. Both are good.
-                if (Setting[e_Comp] < 1.0f) 
-                    tS = Mako_FX_Compressor(tS, channel);
-
-                //R1.00 Write our modified sample back into the sample buffer.
-                channelData[samp] = tS;
-            }
+            if (threadShouldExit()) return;
+            if (Spins++ < Worker_Spins) continue;
+
+            //R1.02 Tell the audio thread to wake us, then check once more before we sleep.
+            //R1.02 The audio thread clears Sleeping when it signals, so it posts at most once per sleep.
+            Sleeping.store(true);
+            if (Job_Posted.load() == Seen) Wake.Wait(100);
+            Sleeping.store(false);
+            Spins = 0;
         }
+
+        //R1.02 The audio thread takes the job back if we are too late to start it.
+        Seen = Job_Posted.load(std::memory_order_acquire);
+        int Prev = Seen - 1;
+        if (! Job_Claimed.compare_exchange_strong(Prev, Seen)) continue;
+
+        MAKO_RT_SCOPE();
+        if (Job_Data_d != nullptr) Proc.Mako_Process_Channel(Job_Data_d, 1, Job_Samples);
+        else Proc.Mako_Process_Channel(Job_Data, 1, Job_Samples);
+        Job_Done.store(Seen, std::memory_order_release);
     }
 }
 
+//R1.02 Write every 2nd sample (averaged with its neighbor) into a scope FIFO. No locks, no allocation.
+//R1.02 If the editor falls behind, the samples that do not fit are dropped.
+template <typename T>
+void MakoBiteAudioProcessor::Mako_Scope_Push(juce::AbstractFifo& Fifo, float* Store, const T* Data, int numSamples)
+{
+    int Count = juce::jmin(numSamples / 2, Fifo.getFreeSpace());
+    int Start1, Size1, Start2, Size2;
+    Fifo.prepareToWrite(Count, Start1, Size1, Start2, Size2);
+
+    for (int t = 0; t < Size1; t++) Store[Start1 + t] = float(Data[t * 2] + Data[t * 2 + 1]) * .5f;
+    for (int t = 0; t < Size2; t++) Store[Start2 + t] = float(Data[(Size1 + t) * 2] + Data[(Size1 + t) * 2 + 1]) * .5f;
+
+    Fifo.finishedWrite(Size1 + Size2);
+}
+
+//R1.02 Read scope samples for the editor. Input and output are read in pairs.
+int MakoBiteAudioProcessor::Mako_Scope_Pull(float* In, float* Out, int Max)
+{
+    int Count = juce::jmin(Max, Scope_FifoIn.getNumReady(), Scope_FifoOut.getNumReady());
+    int Start1, Size1, Start2, Size2;
+
+    Scope_FifoIn.prepareToRead(Count, Start1, Size1, Start2, Size2);
+    for (int t = 0; t < Size1; t++) In[t] = Scope_DataIn[Start1 + t];
+    for (int t = 0; t < Size2; t++) In[Size1 + t] = Scope_DataIn[Start2 + t];
+    Scope_FifoIn.finishedRead(Size1 + Size2);
+
+    Scope_FifoOut.prepareToRead(Count, Start1, Size1, Start2, Size2);
+    for (int t = 0; t < Size1; t++) Out[t] = Scope_DataOut[Start1 + t];
+    for (int t = 0; t < Size2; t++) Out[Size1 + t] = Scope_DataOut[Start2 + t];
+    Scope_FifoOut.finishedRead(Size1 + Size2);
+
+    return Count;
+}
+
 //==============================================================================
 bool MakoBiteAudioProcessor::hasEditor() const
 {
@@ -271,11 +732,13 @@ void MakoBiteAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
     
-    //R1.00 Save our parameters to file/DAW.
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
-   
+    //R1.02 Save our parameters to file/DAW.
+    //R1.02 Binary: Tag, Version, Count, then one float per parameter in Parm_IDs order.
+    juce::MemoryOutputStream Out(destData, false);
+    Out.writeInt(State_Tag);
+    Out.writeInt(State_Version);
+    Out.writeInt(Parm_Cnt);
+    for (int t = 0; t < Parm_Cnt; t++) Out.writeFloat(Parm_Value[t]->load());
 }
 
 void MakoBiteAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -283,31 +746,96 @@ void MakoBiteAudioProcessor::setStateInformation (const void* data, int sizeInBy
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
     
-    //R1.00 Read our parameters from file/DAW.
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+    //R1.02 Our binary state. Parameters are stored in Parm_IDs order.
+    juce::MemoryInputStream In(data, size_t(juce::jmax(0, sizeInBytes)), false);
+    if ((12 <= sizeInBytes) && (In.readInt() == State_Tag))
+    {
+        int Version = In.readInt();
+        int Count = In.readInt();
+
+        //R1.02 Newer versions only add to the end, so read what we know about.
+        //R1.02 Anything an older version did not save goes back to its default.
+        if (1 <= Version)
+        {
+            for (int t = 0; t < Parm_Cnt; t++)
+            {
+                if ((t < Count) && (4 <= In.getNumBytesRemaining()))
+                    Parm_Object[t]->setValueNotifyingHost(Parm_Object[t]->convertTo0to1(In.readFloat()));
+                else
+                    Parm_Object[t]->setValueNotifyingHost(Parm_Object[t]->getDefaultValue());
+            }
+        }
+    }
+    else
+    {
+        //R1.00 Read our parameters from file/DAW. Sessions saved before R1.02 are XML.
+        std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
-    if (xmlState.get() != nullptr)
-        if (xmlState->hasTagName(parameters.state.getType()))
-            parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+        if (xmlState.get() != nullptr)
+            if (xmlState->hasTagName(parameters.state.getType()))
+                parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    }
 
     //R1.00 Force our variables to get updated.
-    Setting[e_Gain] = Mako_GetParmValue_float("gain");
-    Setting[e_NGate] = Mako_GetParmValue_float("ngate");
-    Setting[e_Drive] = Mako_GetParmValue_float("drive");
-    Setting[e_EQ] = Mako_GetParmValue_float("eq");
-    Setting[e_EQ1] = Mako_GetParmValue_float("eq1");
-    Setting[e_EQ2] = Mako_GetParmValue_float("eq2");
-    Setting[e_EQ3] = Mako_GetParmValue_float("eq3");
-    Setting[e_EQ4] = Mako_GetParmValue_float("eq4");
-    Setting[e_EQ5] = Mako_GetParmValue_float("eq5");
-    Setting[e_IR] = Mako_GetParmValue_float("ir");
-    Setting[e_Bottom] = Mako_GetParmValue_float("bottom");
-    Setting[e_Mono] = Mako_GetParmValue_float("mono");
-    Setting[e_Comp] = Mako_GetParmValue_float("comp");
-    Setting[e_HighCut] = Mako_GetParmValue_float("highcut");
-    Setting[e_Sag] = Mako_GetParmValue_float("sag");
-    Setting[e_Asym] = Mako_GetParmValue_float("asym");
-    Setting[e_LowCut] = Mako_GetParmValue_float("lowcut");
+    Mako_Settings_FromParameters();
+}
+
+//R1.02 Copy every parameter into our Settings and flag the processor to recalc.
+void MakoBiteAudioProcessor::Mako_Settings_FromParameters()
+{
+    for (int t = 0; t < Parm_Cnt; t++)
+    {
+        if (Parm_Value[t] != nullptr) Setting[t] = Parm_Value[t]->load();
+    }
+
+    //R1.02 The EQ mode may have changed the band frequencies.
+    Mako_Band_SetFilterValues();
+    SettingsChanged += 1;
+}
+
+//R1.02 new tp_arena() value initialised the arena, so every page has been written already.
+//R1.02 Try to keep it in RAM. Locking can fail (RLIMIT_MEMLOCK), which just leaves it pageable.
+void MakoBiteAudioProcessor::Mako_Arena_Prepare()
+{
+   #if MAKO_LOCK_ARENA && (JUCE_LINUX || JUCE_MAC || JUCE_BSD)
+    if (! Arena_Locked) Arena_Locked = (mlock(Arena.get(), sizeof(tp_arena)) == 0);
+   #endif
+}
+
+//R1.02 Clear all stored samples so old audio does not leak into the next render.
+void MakoBiteAudioProcessor::Mako_Reset_State()
+{
+    tp_chain* Chains[2] = { &Arena->Chain_A, &Arena->Chain_B };
+    for (int c = 0; c < 2; c++)
+    {
+        tp_chain* C = Chains[c];
+        C->IR_Old = nullptr;
+        C->Eco_Model = -1;
+
+        for (int ch = 0; ch < 2; ch++)
+        {
+            //R1.02 Every filter history, the IR and oversampler rings, and the sag. Both sample types.
+            Arena->State[c][ch] = {};
+            Arena->State_d[c][ch] = {};
+
+            //R1.02 Old pool results must never match our new sample positions.
+            MakoTailJob* J = &Tail_Jobs[c][ch];
+            int Expect = MakoTailJob::e_Queued;
+            J->State.compare_exchange_strong(Expect, MakoTailJob::e_Idle);
+            J->Seq = -1;
+            Tail_Use[c][ch] = false;
+        }
+    }
+
+    //R1.02 Any preset fade in progress is over.
+    Chain_Old = nullptr;
+    Preset_FadePos = 0;
+
+    for (int ch = 0; ch < 2; ch++)
+    {
+        Arena->Dyn[ch] = {};
+        for (int p = 0; p < e_CtrlPoints; p++) Arena->Dyn[ch].Ctrl_Gain[p] = 1.0f;
+    }
 }
 
 //R1.00 Parameter reading helper function.
@@ -330,21 +858,137 @@ float MakoBiteAudioProcessor::Mako_GetParmValue_float(juce::String Pstring)
         return 0.0f;
 }
 
-//R1.00 Volume envelope based on average Signal volume.
-float MakoBiteAudioProcessor::Mako_FX_NoiseGate(float tSample, int channel)
+//R1.02 CONTROL RATE - Stages are run in the order they were registered.
+void MakoBiteAudioProcessor::Mako_Ctrl_Register(int Point, const char* Name, tp_ctrltick Tick, tp_ctrlon On)
+{
+    tp_ctrlpoint& P = Ctrl_Points[Point];
+    jassert(P.Cnt < 4);
+    if (4 <= P.Cnt) return;
+    P.Stages[P.Cnt++] = { Name, Tick, On };
+}
+
+//R1.02 Run every stage at Point once per Ctrl_Rate samples and ramp the product of their gains across
+//R1.02 each period. Channels Ch0 to Ch0 + numChannels - 1. Returns true if every sample was silenced.
+template <typename T>
+bool MakoBiteAudioProcessor::Mako_Ctrl_Run(int Point, T* const* Data, int Ch0, int numChannels, int numSamples)
 {
-    //R1.00 Track our Input Signal Average (Absolute vals).
-    Signal_AVG[channel] = (Signal_AVG[channel] * .995) + (abs(tSample) * .005);
+    tp_ctrlpoint& P = Ctrl_Points[Point];
+    bool On[4];
+    bool Idle = true;
+    for (int s = 0; s < P.Cnt; s++)
+    {
+        On[s] = (this->*P.Stages[s].On)();
+        if (On[s]) Idle = false;
+    }
 
-    //R1.00 Create a volume envelope based on Signal Average.
-    Pedal_NGate_Fac[channel] = Signal_AVG[channel] * 10000.0f * (1.1f - Setting[e_NGate]);
+    //R1.02 Nothing is on and nothing has to ramp back to unity.
+    for (int c = 0; c < numChannels; c++)
+        if (Arena->Dyn[Ch0 + c].Ctrl_Gain[Point] != 1.0f) Idle = false;
+    if (Idle) return false;
 
-    //R1.00 Dont amplify the sound, just reduce when necessary.
-    if (1.0f < Pedal_NGate_Fac[channel]) Pedal_NGate_Fac[channel] = 1.0f;
+    T tAbs[Ctrl_Max];
+    T Ramp[Ctrl_Max];
+    bool AllShut = true;
 
-    return tSample * Pedal_NGate_Fac[channel];
+    for (int Pos = 0; Pos < numSamples; Pos += Ctrl_Rate)
+    {
+        int n = juce::jmin(Ctrl_Rate, numSamples - Pos);
+
+        //R1.02 One detector shared by every stage.
+        tp_ctrlin In[2];
+        for (int c = 0; c < numChannels; c++)
+        {
+            juce::FloatVectorOperations::abs(tAbs, Data[c] + Pos, n);
+            float Sum = 0.0f;
+            float Sq = 0.0f;
+            for (int t = 0; t < n; t++)
+            {
+                float a = float(tAbs[t]);
+                Sum += a;
+                Sq += a * a;
+            }
+            In[c] = { float(juce::FloatVectorOperations::findMaximum(tAbs, n)), Sum / float(n), Sq / float(n), n };
+        }
+
+        float Gain[2] = { 1.0f, 1.0f };
+        for (int s = 0; s < P.Cnt; s++)
+        {
+            if (! On[s]) continue;
+            float G[2] = { 1.0f, 1.0f };
+            (this->*P.Stages[s].Tick)(In, Ch0, numChannels, G);
+            Gain[0] *= G[0];
+            Gain[1] *= G[1];
+        }
+
+        //R1.02 Ramp from where the last period ended. Only multiply when the gain changes the signal.
+        for (int c = 0; c < numChannels; c++)
+        {
+            float& Last = Arena->Dyn[Ch0 + c].Ctrl_Gain[Point];
+            T* D = Data[c] + Pos;
+            if (Last == Gain[c])
+            {
+                if (Gain[c] <= 0.0f) juce::FloatVectorOperations::clear(D, n);
+                else if (Gain[c] != 1.0f) juce::FloatVectorOperations::multiply(D, T(Gain[c]), n);
+            }
+            else
+            {
+                float Step = (Gain[c] - Last) / float(n);
+                for (int t = 0; t < n; t++) Ramp[t] = T(Last + Step * float(t + 1));
+                juce::FloatVectorOperations::multiply(D, Ramp, n);
+            }
+
+            if ((0.0f < Last) || (0.0f < Gain[c])) AllShut = false;
+            Last = Gain[c];
+        }
+    }
+
+    return AllShut;
+}
+
+//R1.02 Noise gate with hysteresis, hold, and release. One control period at a time.
+bool MakoBiteAudioProcessor::Mako_Gate_On() const
+{
+    return (0.0f < Setting[e_NGate]);
 }
 
+void MakoBiteAudioProcessor::Mako_Gate_Tick(const tp_ctrlin* In, int Ch0, int numChannels, float* Gain)
+{
+    //R1.02 The original gate was fully open when the envelope * 10000 * (1.1 - NGate) reached 1.
+    //R1.02 Open there and close 6dB lower so the gate does not chatter on a decaying note.
+    float ThreshOpen = 1.0f / (10000.0f * (1.1f - Setting[e_NGate]));
+    float ThreshClose = ThreshOpen * .5f;
+
+    for (int c = 0; c < numChannels; c++)
+    {
+        tp_dyn& D = Arena->Dyn[Ch0 + c];
+        int n = In[c].Len;
+
+        //R1.02 Track our Input Signal Average (Absolute vals). n steps of the one pole move it
+        //R1.02 toward the period's mean by Coef^n.
+        D.Gate_Env = In[c].MeanAbs + (D.Gate_Env - In[c].MeanAbs) * Gate_EnvPow[n];
+
+        //R1.02 Open above the top threshold. Hold open until we are below the bottom threshold long enough.
+        if (ThreshOpen < D.Gate_Env)
+        {
+            D.Gate_Open = 1;
+            D.Gate_Hold = Gate_HoldSamples;
+        }
+        else if (D.Gate_Open)
+        {
+            if (ThreshClose < D.Gate_Env) D.Gate_Hold = Gate_HoldSamples;
+            else if (0 < D.Gate_Hold) D.Gate_Hold -= n;
+            else D.Gate_Open = 0;
+        }
+
+        //R1.02 Ramp the gain so there are no clicks. The scheduler does the ramp inside the period.
+        if (D.Gate_Open)
+            D.Gate_Gain = juce::jmin(1.0f, D.Gate_Gain + Gate_AttackStep * float(n));
+        else
+            D.Gate_Gain = juce::jmax(0.0f, D.Gate_Gain - Gate_ReleaseStep * float(n));
+
+        Gain[c] = D.Gate_Gain;
+    }
+}
 
 //==============================================================================
 // This creates new instances of the plugin..
@@ -354,21 +998,20 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 }
 
 //R1.00 Apply filter to a sample.
-float MakoBiteAudioProcessor::Filter_Calc_BiQuad(float tSample, int channel, tp_filter* fn)
+//R1.02 The history is the sample type, so doubles are never rounded to float between samples.
+template <typename T>
+T MakoBiteAudioProcessor::Filter_Calc_BiQuad(T tSample, const tp_filter& fn, tp_history<T>& h)
 {
-    float tS = tSample;
-
-    fn->xn0[channel] = tS;
-    tS = fn->a0 * fn->xn0[channel] + fn->a1 * fn->xn1[channel] + fn->a2 * fn->xn2[channel] - fn->b1 * fn->yn1[channel] - fn->b2 * fn->yn2[channel];
-    fn->xn2[channel] = fn->xn1[channel]; fn->xn1[channel] = fn->xn0[channel]; fn->yn2[channel] = fn->yn1[channel]; fn->yn1[channel] = tS;
+    T tS = fn.a0 * tSample + fn.a1 * h.xn1 + fn.a2 * h.xn2 - fn.b1 * h.yn1 - fn.b2 * h.yn2;
+    h.xn2 = h.xn1; h.xn1 = tSample; h.yn2 = h.yn1; h.yn1 = tS;
 
     return tS;
 }
 
 //R1.00 Second order parametric/peaking boost filter with constant-Q
-void MakoBiteAudioProcessor::Filter_BP_Coeffs(float Gain_dB, float Fc, float Q, tp_filter* fn)
+void MakoBiteAudioProcessor::Filter_BP_Coeffs(float Gain_dB, float Fc, float Q, tp_filter* fn, float Fs)
 {    
-    float K = pi2 * (Fc * .5f) / SampleRate;
+    float K = pi2 * (Fc * .5f) / Fs;
     float K2 = K * K;
     float V0 = pow(10.0, Gain_dB / 20.0);
 
@@ -383,14 +1026,12 @@ void MakoBiteAudioProcessor::Filter_BP_Coeffs(float Gain_dB, float Fc, float Q,
     fn->a2 = g * dd;
     fn->b1 = b * dd;
     fn->b2 = d * dd;
-    fn->c0 = 1.0f;
-    fn->d0 = 0.0f;
 }
 
 //R1.00 Second order butterworth LOW PASS filter. 
-void MakoBiteAudioProcessor::Filter_LP_Coeffs(float fc, tp_filter* fn)
+void MakoBiteAudioProcessor::Filter_LP_Coeffs(float fc, tp_filter* fn, float Fs)
 {    
-    float c = 1.0f / (tanf(pi * fc / SampleRate));
+    float c = 1.0f / (tanf(pi * fc / Fs));
     fn->a0 = 1.0f / (1.0f + sqrt2 * c + (c * c));
     fn->a1 = 2.0f * fn->a0;
     fn->a2 = fn->a0;
@@ -399,9 +1040,9 @@ void MakoBiteAudioProcessor::Filter_LP_Coeffs(float fc, tp_filter* fn)
 }
 
 //R1.00 Second order butterworth HIGH PASS filter.
-void MakoBiteAudioProcessor::Filter_HP_Coeffs(float fc, tp_filter* fn)
+void MakoBiteAudioProcessor::Filter_HP_Coeffs(float fc, tp_filter* fn, float Fs)
 {    
-    float c = tanf(pi * fc / SampleRate);
+    float c = tanf(pi * fc / Fs);
     fn->a0 = 1.0f / (1.0f + sqrt2 * c + (c * c));
     fn->a1 = -2.0f * fn->a0;
     fn->a2 = fn->a0;
@@ -409,54 +1050,116 @@ void MakoBiteAudioProcessor::Filter_HP_Coeffs(float fc, tp_filter* fn)
     fn->b2 = fn->a0 * (1.0f - sqrt2 * c + (c * c));
 }
 
+//R1.02 ADAA - First order antiderivative anti-aliasing. Each shaper outputs its average between the
+//R1.02 last input and this one, (F(x) - F(x1)) / (x - x1), which removes most of the aliasing without
+//R1.02 oversampling. When the inputs are too close to divide by, we use the shaper at their midpoint.
+//R1.02 Done in double since F(x) grows with x and the difference would lose its bits in float.
+static inline double Mako_LogCosh(double x)
+{
+    double a = std::abs(x);
+    return a + std::log1p(std::exp(-2.0 * a)) - 0.69314718055994531;
+}
+
+template <typename T>
+static inline T Mako_ADAA_Tanh(T x, double& X1, double& F1)
+{
+    double X = double(x);
+    double F = Mako_LogCosh(X);
+    double dX = X - X1;
+    double y = (std::abs(dX) < 1.0e-5) ? std::tanh(.5 * (X + X1)) : (F - F1) / dX;
+    X1 = X;
+    F1 = F;
+    return T(y);
+}
+
+//R1.02 The asymmetry shaper is x above 0 and x - .5Ax + .5Ax^2 below, and its antiderivative.
+//R1.02 F(x1) is recalculated every time since A can change between samples.
+static inline double Mako_Asym(double x, double A)
+{
+    return (0.0 <= x) ? x : x - .5 * A * x + .5 * A * x * x;
+}
+
+static inline double Mako_Asym_AD(double x, double A)
+{
+    return (0.0 <= x) ? .5 * x * x : (1.0 - .5 * A) * .5 * x * x + A * x * x * x / 6.0;
+}
+
+template <typename T>
+static inline T Mako_ADAA_Asym(T x, double A, double& X1)
+{
+    double X = double(x);
+    double dX = X - X1;
+    double y = (std::abs(dX) < 1.0e-5) ? Mako_Asym(.5 * (X + X1), A) : (Mako_Asym_AD(X, A) - Mako_Asym_AD(X1, A)) / dX;
+    X1 = X;
+    return T(y);
+}
+
 //R1.01 Apply an amplifier effect to the sample.
-float MakoBiteAudioProcessor::Mako_FX_AmpSim(float tSample, int channel)
+template <typename T>
+T MakoBiteAudioProcessor::Mako_FX_AmpSim(T tSample, tp_chain* C, tp_state<T>* S)
 {
-    float tS = tSample;
-    float tS2;
-    float tDelta;
+    //R1.02 Everything comes from the chain so an old chain can keep playing during a preset fade.
+    T tS = tSample;
+    T tS2;
+    T tDelta;
     
     //*******************************************
     //R1.01 DISTORTION SECTION
     //*******************************************
     //R1.00 Apply EQ. Try to not to calc, if not needed, to save CPU cycles.    
-    if (Setting[e_EQ1] != .0f) tS = Filter_Calc_BiQuad(tS, channel, &makoF_Band1);
-    if (Setting[e_EQ2] != .0f) tS = Filter_Calc_BiQuad(tS, channel, &makoF_Band2);
-    if (Setting[e_EQ3] != .0f) tS = Filter_Calc_BiQuad(tS, channel, &makoF_Band3);
-    if (Setting[e_EQ4] != .0f) tS = Filter_Calc_BiQuad(tS, channel, &makoF_Band4);
-    if (Setting[e_EQ5] != .0f) tS = Filter_Calc_BiQuad(tS, channel, &makoF_Band5);
+    //R1.02 An SVF band keeps running until its gain has glided back to 0.
+    if (SVF)
+    {
+        for (int b = 0; b < 5; b++)
+            if ((C->Set[e_EQ1 + b] != .0f) || (S->SVF_Band[b].c1 != .0f)) tS = Filter_Calc_SVF(tS, C->makoS_Band[b], S->SVF_Band[b]);
+    }
+    else
+    {
+    if (C->Set[e_EQ1] != .0f) tS = Filter_Calc_BiQuad(tS, C->makoF_Band1, S->Band[0]);
+    if (C->Set[e_EQ2] != .0f) tS = Filter_Calc_BiQuad(tS, C->makoF_Band2, S->Band[1]);
+    if (C->Set[e_EQ3] != .0f) tS = Filter_Calc_BiQuad(tS, C->makoF_Band3, S->Band[2]);
+    if (C->Set[e_EQ4] != .0f) tS = Filter_Calc_BiQuad(tS, C->makoF_Band4, S->Band[3]);
+    if (C->Set[e_EQ5] != .0f) tS = Filter_Calc_BiQuad(tS, C->makoF_Band5, S->Band[4]);
+    }
 
     //R1.00 Soft Clipping.
-    tS = tanhf(tS * (.1f + (Setting[e_Drive] * Setting[e_Drive]) * 50.0f));
+    tS *= (.1f + (C->Set[e_Drive] * C->Set[e_Drive]) * 50.0f);
+    tS = ADAA ? Mako_ADAA_Tanh(tS, S->ADAA_X[a_Drive], S->ADAA_F[a_Drive]) : Mako_Tanh(tS);
    
     //*******************************************
     //R1.01 Add some asymmetric distortion. 
     //*******************************************
-    if ((0.0f < Setting[e_Asym]) && (tS < 0.0f))
+    if (ADAA)
+    {
+        //R1.02 Always track the input so turning Asym up does not start from an old one.
+        if (0.0f < C->Set[e_Asym]) tS = Mako_ADAA_Asym(tS, double(C->Set[e_Asym]), S->ADAA_X[a_Asym]);
+        else S->ADAA_X[a_Asym] = double(tS);
+    }
+    else if ((0.0f < C->Set[e_Asym]) && (tS < 0.0f))
     {        
         //R1.01 Gradually decrease volume and flatten out the peaks.
         //R1.01 Since we ignore +, we get a normal sine wave on top(+) and a squarish wave on bottom(-).
-        tS = tS - (tS * (0.5 * Setting[e_Asym])) + (tS * tS) * (Setting[e_Asym] * 0.5);
+        tS = tS - (tS * (0.5 * C->Set[e_Asym])) + (tS * tS) * (C->Set[e_Asym] * 0.5);
     }
 
     //*****************************************************
     //R1.01 Power amp SAG.
     //*****************************************************
-    if (0.0f < Setting[e_Sag])
+    if (0.0f < C->Set[e_Sag])
     {
         //R1.01 Gradually decrease the gain as the volume goes up. But only on the rise side of the signal.
         //R1.01 Principle being the power supply will struggle more and more to drive the voltage as our signal goes up.
         if (0.0f < tS)
         {
-            tDelta = 1.0f - Sag_Last[channel];
-            if (Sag_Last[channel] < tS) tS = Sag_Last[channel] + ((tS - Sag_Last[channel]) * (tDelta) * (1.0f - Setting[e_Sag]));
+            tDelta = 1.0f - S->Sag_Last;
+            if (S->Sag_Last < tS) tS = S->Sag_Last + ((tS - S->Sag_Last) * (tDelta) * (1.0f - C->Set[e_Sag]));
         }
         else
         {
-            tDelta = 1.0f + Sag_Last[channel];
-            if (tS < Sag_Last[channel]) tS = Sag_Last[channel] - ((Sag_Last[channel] - tS) * (tDelta) * (1.0f - Setting[e_Sag]));
+            tDelta = 1.0f + S->Sag_Last;
+            if (tS < S->Sag_Last) tS = S->Sag_Last - ((S->Sag_Last - tS) * (tDelta) * (1.0f - C->Set[e_Sag]));
         }
-        Sag_Last[channel] = tS;
+        S->Sag_Last = tS;
     }
 
     //*****************************************************
@@ -465,19 +1168,25 @@ float MakoBiteAudioProcessor::Mako_FX_AmpSim(float tSample, int channel)
     //R1.01 Reduce our gain a little since we will be at MAX volume after clipping.
     //R1.01 This reduces highs. Giving a softer and less harsh sound. 
     tS *= .2f;
-    if (Setting[e_HighCut] < 6000.0f) tS = Filter_Calc_BiQuad(tS, channel, &makoF_HighCut);
+    if (SVF)
+    {
+        if ((C->Set[e_HighCut] < 6000.0f) || (S->SVF_HighCut.g != C->makoS_HighCut.g)) tS = Filter_Calc_SVF(tS, C->makoS_HighCut, S->SVF_HighCut);
+    }
+    else if (C->Set[e_HighCut] < 6000.0f) tS = Filter_Calc_BiQuad(tS, C->makoF_HighCut, S->HighCut);
 
     //*****************************************************
     //R1.01 CHIMERA SECTION - Give a bassy/bright EQ sound.
     //R1.01 Think of it as a Woofer Tweeter setup.  
     //*****************************************************
     //R1.01 Calc Low Pass filter and apply drive.
-    float tS1 = Filter_Calc_BiQuad(tS, channel, &makoF_ChimeraLow);
-    tS1 = tanhf(tS1 * Setting[e_Bottom] * 3.0f);
+    T tS1 = Filter_Calc_BiQuad(tS, C->makoF_ChimeraLow, S->ChimeraLow);
+    tS1 *= C->Set[e_Bottom] * 3.0f;
+    tS1 = ADAA ? Mako_ADAA_Tanh(tS1, S->ADAA_X[a_Low], S->ADAA_F[a_Low]) : Mako_Tanh(tS1);
 
     //R1.00 Calc High Pass filter and apply drive.
-    tS2 = Filter_Calc_BiQuad(tS, channel, &makoF_ChimeraHigh);
-    tS2 = tanhf(tS2 * 3.0f);
+    tS2 = Filter_Calc_BiQuad(tS, C->makoF_ChimeraHigh, S->ChimeraHigh);
+    tS2 *= 3.0f;
+    tS2 = ADAA ? Mako_ADAA_Tanh(tS2, S->ADAA_X[a_High], S->ADAA_F[a_High]) : Mako_Tanh(tS2);
     
     //R1.00 Mix the Chimera HIGH and LOW signals together.
     tS = (tS1 + tS2) * .5f;
@@ -485,75 +1194,473 @@ float MakoBiteAudioProcessor::Mako_FX_AmpSim(float tSample, int channel)
     //R1.01 The more Bottom we add, we start to get too much signal below 80 Hz. 
     //R1.01 Which makes string and pick noise get loud and weird. 
     //R1.01 Added a switch in case we are playing Bass thru this and want all the lows.
-    if (.5f < Setting[e_LowCut]) tS = Filter_Calc_BiQuad(tS, channel, &makoF_HighPass);
+    if (.5f < C->Set[e_LowCut]) tS = SVF ? Filter_Calc_SVF(tS, C->makoS_HighPass, S->SVF_HighPass) : Filter_Calc_BiQuad(tS, C->makoF_HighPass, S->HighPass);
 
     //R1.00 Volume/Gain adjust.
-    return Setting[e_Gain] * Setting[e_Gain] * tS * 6.0f;
+    return C->Set[e_Gain] * C->Set[e_Gain] * tS * 6.0f;
 }
 
-//R1.00 MAKO COMPRESSOR
-float MakoBiteAudioProcessor::Mako_FX_Compressor(float tSample, int channel)
+//R1.02 Amp then cab for one chain.
+template <typename T>
+T MakoBiteAudioProcessor::Mako_Chain_Process(T tSample, int channel, tp_chain* C, tp_state<T>* S, int samp)
 {
-    float tSa = abs(tSample);
-    float tThresh = Setting[e_Comp] * Setting[e_Comp]; //R1.00 Square THRESH to give us more range on the knob.
-    float diff;
-    float Ratio = .4f;  //R1.00 Compressor RATIO. Fixed at .4.
+    //R1.00 Apply our Distortion to the sample. 
+    //R1.02 Oversampled when the offline profile asks for it.
+    T tS = (OS_Factor == 1) ? Mako_FX_AmpSim(tSample, C, S) : Mako_Amp_Oversampled(tSample, C, S);
 
-    //R1.00 If our signal is above the Threshold.
-    if (tThresh < tSa)
-    {
-        //R1.00 Get Difference in Gain and Threshold.    
-        diff = tSa - tThresh;
+    //R1.00 Impulse Response (IR).
+    //R1.02 Or the eco cab filters fitted to it.
+    if (0.0f < C->Set[e_IR]) tS = Eco ? Mako_CabEco(tS, C, S) : Mako_CabSim(tS, channel, C, S, samp);
 
-        //R1.00 Calc what our new gain reduction value should be.
-        Pedal_CompGain[channel] = (tThresh + (diff * Ratio)) / tSa;
+    return tS;
+}
 
-        //R1.00 Slowly modify our GAIN adjuster to the new gain value. 
-        if (Pedal_CompGain[channel] < Pedal_CompGainAdj[channel])
-        {
-            //R1.00 To have a comp attack we need a 2nd var that we adjust up to the actual max. So the comp slowly begins working.
-            //R1.00 ATTACK - Slowly reduce the gain to the desired value.
-            Pedal_CompGainAdj[channel] -= Release_500mS * 170.0f;
-            if (Pedal_CompGainAdj[channel] < 0.0f) Pedal_CompGainAdj[channel] = 0.0f;
-        }
-        else
+//R1.02 Upsample one sample, run the amp on each new sample, and decimate back down.
+//R1.02 Up uses every OS_Factor'th tap per phase. Down keeps the last phase, which makes the
+//R1.02 total delay exactly OS_Taps - 1 samples.
+template <typename T>
+T MakoBiteAudioProcessor::Mako_Amp_Oversampled(T tSample, tp_chain* C, tp_state<T>* S)
+{
+    auto& Ch = *S;
+    const int N = OS_Taps * OS_Factor;
+    const float* H = Profile->OS_Coeffs;
+
+    Ch.OS_InIdx = (Ch.OS_InIdx == 0) ? OS_Taps - 1 : Ch.OS_InIdx - 1;
+    Ch.OS_In[Ch.OS_InIdx] = Ch.OS_In[Ch.OS_InIdx + OS_Taps] = tSample;
+    const T* X = Ch.OS_In + Ch.OS_InIdx;
+
+    for (int j = 0; j < OS_Factor; j++)
+    {
+        T Up = 0;
+        for (int k = 0; k < OS_Taps; k++) Up += H[k * OS_Factor + j] * X[k];
+
+        T Amp = Mako_FX_AmpSim(T(Up * OS_Factor), C, S);
+        Ch.OS_OutIdx = (Ch.OS_OutIdx == 0) ? N - 1 : Ch.OS_OutIdx - 1;
+        Ch.OS_Out[Ch.OS_OutIdx] = Ch.OS_Out[Ch.OS_OutIdx + N] = Amp;
+    }
+
+    const T* A = Ch.OS_Out + Ch.OS_OutIdx;
+    T Down = 0;
+    for (int i = 0; i < N; i++) Down += H[i] * A[i];
+
+    return Down;
+}
+
+//R1.02 Kaiser windowed sinc at the base rate Nyquist, for the profile's OS_Factor. About 80dB down in the stop band.
+void MakoBiteAudioProcessor::Mako_OS_Design(tp_profile* P)
+{
+    auto I0 = [](double x)
+    {
+        double Sum = 1.0, Term = 1.0;
+        for (int k = 1; k < 30; k++)
         {
-            //R1.00 RELEASE - Adjust the gain back up to 1.0f.
-            Pedal_CompGainAdj[channel] += Release_500mS * 17.0f;
-            if (1.0f < Pedal_CompGainAdj[channel]) Pedal_CompGainAdj[channel] = 1.0f;
+            Term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            Sum += Term;
         }
+        return Sum;
+    };
+
+    const double Beta = 8.0;
+    int N = OS_Taps * P->OS_Factor;
+    double Sum = 0.0;
+    for (int t = 0; t < N; t++)
+    {
+        double x = double(t) - double(N - 1) * .5;      //R1.02 N is even so x is never 0.
+        double a = juce::MathConstants<double>::pi * x / P->OS_Factor;
+        double r = 2.0 * x / double(N - 1);
+        double h = (sin(a) / a) * I0(Beta * sqrt(juce::jmax(0.0, 1.0 - r * r))) / I0(Beta);
+        P->OS_Coeffs[t] = float(h);
+        Sum += h;
+    }
+
+    //R1.02 Unity gain at DC.
+    for (int t = 0; t < N; t++) P->OS_Coeffs[t] = float(P->OS_Coeffs[t] / Sum);
+}
+
+//R1.02 Design everything the realtime or offline profile needs for its amp rate.
+//R1.02 prepareToPlay or Mako_Profile_Follow only. Never while the audio thread is using P.
+void MakoBiteAudioProcessor::Mako_Profile_Design(tp_profile* P, bool IsOffline)
+{
+    MAKO_TRACE_SCOPE("Mako_Profile_Design");
+    int Parm = juce::jlimit(0, 3, int(Parm_Value[e_Offline]->load()));
+    if (IsOffline) Offline_Parm = Parm;
+    P->NonRealtime = IsOffline;
+    P->Offline = IsOffline && (0 < Parm);
+    P->OS_Factor = P->Offline ? (1 << Parm) : 1;
+    P->Amp_Rate = SampleRate * float(P->OS_Factor);
+    if (1 < P->OS_Factor) Mako_OS_Design(P);
+
+    //R1.02 SVF glide. 1 - e^(-1 / (5mS * Amp_Rate)).
+    P->Svf_Glide = 1.0f - expf(-1.0f / (.005f * P->Amp_Rate));
+
+    //R1.00 Calculate the fixed value filters.
+    //Filter_BP_Coeffs(12.0f, 150.0f, 1.414, &makoF_ChimeraLow);     
+    Filter_LP_Coeffs(150.0f, &P->makoF_ChimeraLow, P->Amp_Rate);
+    Filter_HP_Coeffs(1500.0f, &P->makoF_ChimeraHigh, P->Amp_Rate);
+    Filter_HP_Coeffs(80.0f, &P->makoF_HighPass, P->Amp_Rate);
+    Filter_SVF_HP(80.0f, &P->makoS_HighPass, P->Amp_Rate);
+
+    //R1.02 Design every preset now so switching never calcs coefficients.
+    for (int t = 0; t < Preset_Cnt; t++) Mako_Preset_Design(&P->Presets[t], Preset_Values[t], P->Amp_Rate);
+
+    P->Latency = (1 < P->OS_Factor) ? OS_Taps - 1 : 0;
+}
+
+//R1.02 Play a profile that is already designed. Only copies, so processBlock can call it when the
+//R1.02 host starts or stops a bounce. The next Mako_Settings_Update redesigns the playing chain's EQ
+//R1.02 for the new amp rate.
+void MakoBiteAudioProcessor::Mako_Profile_Use(int Index)
+{
+    MAKO_TRACE_SCOPE("Mako_Profile_Use");
+    Profile = &Arena->Profiles[Index];
+    NonRealtime = Profile->NonRealtime;
+    Offline = Profile->Offline;
+    OS_Factor = Profile->OS_Factor;
+    Amp_Rate = Profile->Amp_Rate;
+    Svf_Glide = Profile->Svf_Glide;
+    Offline_Active.store(NonRealtime);
+    Offline_Owner.store((Index == 1) ? e_OwnerAudio : e_OwnerFree, std::memory_order_release);
+
+    //R1.02 Start at full quality. Bounces stay there.
+    Gov_Level = 0;
+    Gov_Level_Now.store(0);
+    Gov_Load = 0.0f;
+    Gov_HoldHigh = Gov_HoldLow = 0;
+    Tanh_Fast = false;
+    Cab_Keep = Cab_Taps = 1024;
+
+    //R1.02 Both chains get the fixed filters so either one can play.
+    tp_chain* Chains[2] = { &Arena->Chain_A, &Arena->Chain_B };
+    for (int c = 0; c < 2; c++)
+    {
+        Chains[c]->makoF_ChimeraLow = Profile->makoF_ChimeraLow;
+        Chains[c]->makoF_ChimeraHigh = Profile->makoF_ChimeraHigh;
+        Chains[c]->makoF_HighPass = Profile->makoF_HighPass;
+        Chains[c]->makoS_HighPass = Profile->makoS_HighPass;
+
+    }
+    Mako_State_All([](auto& S, int)
+    {
+        juce::FloatVectorOperations::clear(S.OS_In, OS_Taps * 2);
+        juce::FloatVectorOperations::clear(S.OS_Out, OS_Taps * OS_Max * 2);
+    });
+
+    //R1.02 The IR is 1024 samples long. Give the filters another 50mS to die out.
+    Gate_TailSamples = 1024 + int(.050f * SampleRate) + Profile->Latency;
+}
+
+//R1.02 Hosts call this when a bounce starts or ends, some from the audio thread. Both profiles are
+//R1.02 already designed, so only flag the one we want. processBlock swaps to it.
+void MakoBiteAudioProcessor::setNonRealtime (bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime(isNonRealtime);
+    Profile_Want.store(isNonRealtime ? 1 : 0, std::memory_order_release);
+}
+
+void MakoBiteAudioProcessor::Mako_Profile_Follow()
+{
+    //R1.02 Redesign the offline profile for a new Offline HQ. Wait if a bounce is playing it.
+    int Parm = juce::jlimit(0, 3, int(Parm_Value[e_Offline]->load()));
+    int Free = e_OwnerFree;
+    if ((0 <= Offline_Parm) && (Parm != Offline_Parm) && Offline_Owner.compare_exchange_strong(Free, e_OwnerDesign))
+    {
+        Mako_Profile_Design(&Arena->Profiles[1], true);
+        Offline_Owner.store(e_OwnerFree, std::memory_order_release);
+    }
+
+    int Latency = Arena->Profiles[Profile_Want.load()].Latency;
+    if (getLatencySamples() != Latency) setLatencySamples(Latency);
+}
+
+//R1.02 Reference tanh, or Lambert's continued fraction when the governor asks for it.
+//R1.02 The fast one is within 1e-4 of tanh, so changing tiers does not click.
+template <typename T>
+T MakoBiteAudioProcessor::Mako_Tanh(T x) const
+{
+    if (! Tanh_Fast) return std::tanh(x);
+
+    x = juce::jlimit(T(-4.97), T(4.97), x);
+    T x2 = x * x;
+    T y = x * (T(135135) + x2 * (T(17325) + x2 * (T(378) + x2))) / (T(135135) + x2 * (T(62370) + x2 * (T(3150) + T(28) * x2)));
+    return juce::jlimit(T(-1), T(1), y);
+}
+
+//R1.02 Track our load and step the quality. Never while the IR is still fading from the last step.
+void MakoBiteAudioProcessor::Mako_Gov_Update(double Seconds, int numSamples)
+{
+    if (numSamples <= 0) return;
+
+    //R1.02 A tool has pinned the level. Step to it like the load would, one fade at a time.
+    int Force = Gov_Force.load(std::memory_order_relaxed);
+    if (0 <= Force)
+    {
+        if ((Force != Gov_Level) && (Cab_Keep == Cab_Taps)) Mako_Gov_SetLevel(Gov_Level + ((Gov_Level < Force) ? 1 : -1));
+        return;
+    }
+
+    //R1.02 Bounces have no deadline and the governor can be turned off.
+    if (NonRealtime || (Setting[e_Governor] < .5f))
+    {
+        if ((Gov_Level != 0) && (Cab_Keep == Cab_Taps)) Mako_Gov_SetLevel(0);
+        Gov_Load = 0.0f;
+        Gov_HoldHigh = Gov_HoldLow = 0;
+        return;
+    }
+
+    //R1.02 Smooth over about 100mS so one slow block from the host does not count.
+    float Load = float(Seconds * SampleRate / numSamples);
+    Gov_Load += (Load - Gov_Load) * juce::jmin(1.0f, float(numSamples) / (.1f * SampleRate));
+
+    Gov_HoldHigh = (Gov_High < Gov_Load) ? Gov_HoldHigh + numSamples : 0;
+    Gov_HoldLow = (Gov_Load < Gov_Low) ? Gov_HoldLow + numSamples : 0;
+    if (Cab_Keep != Cab_Taps) return;
+
+    //R1.02 Step down quickly, step back up slowly.
+    if ((Gov_Level < Gov_Levels - 1) && (.050f * SampleRate <= Gov_HoldHigh))
+    {
+        Mako_Gov_SetLevel(Gov_Level + 1);
+        Gov_HoldHigh = 0;
+    }
+    else if ((0 < Gov_Level) && (2.0f * SampleRate <= Gov_HoldLow))
+    {
+        Mako_Gov_SetLevel(Gov_Level - 1);
+        Gov_HoldLow = 0;
+    }
+}
+
+//R1.02 The IR ring always holds 1024 samples, so taps can be faded back in at any time.
+void MakoBiteAudioProcessor::Mako_Gov_SetLevel(int Level)
+{
+    Gov_Level = juce::jlimit(0, Gov_Levels - 1, Level);
+    Gov_Level_Now.store(Gov_Level);
+    Tanh_Fast = Gov_Table[Gov_Level].Tanh_Fast;
+
+    int Taps = Gov_Table[Gov_Level].IR_Taps;
+    if (Taps == Cab_Keep) return;
+
+    if (Taps < Cab_Keep)
+    {
+        Cab_Taps = Cab_Keep;
+        Cab_Keep = Taps;
+        Cab_Fade0 = 1.0f;
+        Cab_Fade1 = 0.0f;
     }
     else
     {
-        //R1.00 Signal is BELOW the threshold, RELEASE - Adjust the gain back up to 1.0f.
-        Pedal_CompGainAdj[channel] += Release_500mS * 17.0f;
-        if (1.0f < Pedal_CompGainAdj[channel]) Pedal_CompGainAdj[channel] = 1.0f;
+        Cab_Taps = Taps;
+        Cab_Fade0 = 0.0f;
+        Cab_Fade1 = 1.0f;
     }
+    Cab_FadePos = 0;
+}
 
-    return tSample * Pedal_CompGainAdj[channel];    
+//R1.02 Fast log2 and 2^x. Close enough for a gain computer (about .03dB). The compressor only
+//R1.02 needs one per channel each control period, the scheduler ramps between them.
+static inline float Mako_FastLog2(float x)
+{
+    juce::uint32 i;
+    std::memcpy(&i, &x, 4);
+    float e = float(int((i >> 23) & 255) - 127);
+    i = (i & 0x007FFFFF) | 0x3F800000;
+    float m;
+    std::memcpy(&m, &i, 4);
+    return e + (-0.34484843f * m + 2.02466578f) * m - 0.67487759f;
 }
 
+static inline float Mako_FastExp2(float x)
+{
+    x = juce::jlimit(-126.0f, 126.0f, x);
+    int w = int(x);
+    if (x < float(w)) w--;
+    float z = x - float(w);
+    juce::uint32 i = juce::uint32(w + 127) << 23;
+    float Scale;
+    std::memcpy(&Scale, &i, 4);
+    return Scale * (1.0f + z * (0.6951786f + z * (0.2261475f + z * 0.0780407f)));
+}
+
+//R1.02 tan(x) for 0 <= x < pi/2. Pade approximant, good to 1e-8 below .8 (about 12kHz at 48kHz).
+static inline float Mako_FastTan(float x)
+{
+    float x2 = x * x;
+    return x * (945.0f - 105.0f * x2 + x2 * x2) / (945.0f - 420.0f * x2 + 15.0f * x2 * x2);
+}
+
+//R1.02 SVF - Zavalishin's topology preserving transform of the state variable filter (Simper's form).
+//R1.02 The state is two integrators, so changing g, k or the output mix never blows up.
+template <typename T>
+T MakoBiteAudioProcessor::Filter_Calc_SVF(T tSample, const tp_svf& f, tp_svfstate<T>& s)
+{
+    if ((s.g != f.g) || (s.k != f.k) || (s.c1 != f.c1)) Filter_SVF_Glide(f, s);
+
+    float a2 = s.g * s.a1;
+    float a3 = s.g * a2;
+    T v3 = tSample - s.ic2;
+    T v1 = s.a1 * s.ic1 + a2 * v3;
+    T v2 = s.ic2 + a2 * s.ic1 + a3 * v3;
+    s.ic1 = 2.0f * v1 - s.ic1;
+    s.ic2 = 2.0f * v2 - s.ic2;
+
+    return f.c0 * tSample + s.c1 * v1 + f.c2 * v2;
+}
+
+//R1.02 One step toward the targets. A filter that was never run jumps straight there,
+//R1.02 except a bell's gain, which fades in from flat.
+template <typename T>
+void MakoBiteAudioProcessor::Filter_SVF_Glide(const tp_svf& f, tp_svfstate<T>& s)
+{
+    if (s.g <= 0.0f)
+    {
+        s.g = f.g;
+        s.k = f.k;
+        if (f.c2 != 0.0f) s.c1 = f.c1;
+    }
+
+    if ((std::abs(f.g - s.g) < 1.0e-6f * f.g) && (std::abs(f.k - s.k) < 1.0e-5f) && (std::abs(f.c1 - s.c1) < 1.0e-5f))
+    {
+        s.g = f.g;
+        s.k = f.k;
+        s.c1 = f.c1;
+    }
+    else
+    {
+        s.g += (f.g - s.g) * Svf_Glide;
+        s.k += (f.k - s.k) * Svf_Glide;
+        s.c1 += (f.c1 - s.c1) * Svf_Glide;
+    }
+    s.a1 = 1.0f / (1.0f + s.g * (s.g + s.k));
+}
+
+//R1.02 Same response as Filter_BP_Coeffs, which uses K = pi * Fc / Fs without the tan.
+//R1.02 (s^2 + V0 s / Q + 1) / (s^2 + s / Q + 1) = In + (V0 - 1) / Q * Band.
+void MakoBiteAudioProcessor::Filter_SVF_Bell(float Gain_dB, float Fc, float Q, tp_svf* f, float Fs)
+{
+    float V0 = Mako_FastExp2(Gain_dB * .16609640f);   //R1.02 10^(dB / 20).
+    f->g = pi * Fc / Fs;
+    f->k = 1.0f / Q;
+    f->c0 = 1.0f;
+    f->c1 = (Gain_dB == 0.0f) ? 0.0f : (V0 - 1.0f) * f->k;
+    f->c2 = 0.0f;
+}
+
+//R1.02 Butterworth low and high pass. Same response as Filter_LP_Coeffs and Filter_HP_Coeffs.
+void MakoBiteAudioProcessor::Filter_SVF_LP(float fc, tp_svf* f, float Fs)
+{
+    f->g = Mako_FastTan(pi * juce::jmin(fc, .49f * Fs) / Fs);
+    f->k = sqrt2;
+    f->c0 = 0.0f;
+    f->c1 = 0.0f;
+    f->c2 = 1.0f;
+}
+
+void MakoBiteAudioProcessor::Filter_SVF_HP(float fc, tp_svf* f, float Fs)
+{
+    f->g = Mako_FastTan(pi * juce::jmin(fc, .49f * Fs) / Fs);
+    f->k = sqrt2;
+    f->c0 = 1.0f;
+    f->c1 = -sqrt2;
+    f->c2 = -1.0f;
+}
+
+//R1.02 Attack and release coefficients for one control rate step.
+void MakoBiteAudioProcessor::Mako_Comp_SetTimes()
+{
+    Setting_Last[e_CompAtk] = Setting[e_CompAtk];
+    Setting_Last[e_CompRel] = Setting[e_CompRel];
+
+    float AtkS = juce::jmax(.0001f, Setting[e_CompAtk] * .001f);
+    float RelS = juce::jmax(.001f, Setting[e_CompRel] * .001f);
+    Comp_AtkCoef = expf(-float(Ctrl_Rate) / (AtkS * SampleRate));
+    Comp_RelCoef = expf(-float(Ctrl_Rate) / (RelS * SampleRate));
+}
+
+//R1.02 MAKO COMPRESSOR
+//R1.02 Envelope detector (peak or RMS) feeding a log domain gain computer with a soft knee.
+//R1.02 Runs once every control period. The scheduler ramps the gain in between.
+bool MakoBiteAudioProcessor::Mako_Comp_On() const
+{
+    return (Setting[e_Comp] < 1.0f);
+}
+
+void MakoBiteAudioProcessor::Mako_Comp_Tick(const tp_ctrlin* In, int Ch0, int numChannels, float* Gain)
+{
+    //R1.00 Square THRESH to give us more range on the knob. Then convert to log2 units (1 = 6.02dB).
+    float tThresh = Setting[e_Comp] * Setting[e_Comp];
+    float ThreshL2 = Mako_FastLog2(juce::jmax(tThresh, 1.0e-6f));
+    float Slope = 1.0f / juce::jmax(1.0f, Setting[e_CompRatio]) - 1.0f;
+    float KneeL2 = Setting[e_CompKnee] / 6.0206f;
+    bool RMS = (.5f < Setting[e_CompRMS]);
+    bool Link = (.5f < Setting[e_CompLink]) && (1 < numChannels);
+
+    //R1.02 DETECTOR - Peak or mean square of the period, smoothed with attack/release.
+    float Level[2];
+    for (int c = 0; c < numChannels; c++)
+    {
+        float& Env = Arena->Dyn[Ch0 + c].Comp_Level;
+        float X = RMS ? In[c].MeanSq : In[c].Peak;
+        float Coef = (Env < X) ? Comp_AtkCoef : Comp_RelCoef;
+        Env = X + (Env - X) * Coef;
+        Level[c] = juce::jmax(Env, 1.0e-9f);
+    }
+
+    //R1.02 Stereo link - Both channels follow the loudest one.
+    if (Link) Level[0] = Level[1] = juce::jmax(Level[0], Level[1]);
+
+    //R1.02 GAIN COMPUTER - In log2 units. Mean square is already squared so halve it.
+    float LogScale = RMS ? .5f : 1.0f;
+    for (int c = 0; c < numChannels; c++)
+    {
+        float Over = Mako_FastLog2(Level[c]) * LogScale - ThreshL2;
+        float Knee = (Over + KneeL2 * .5f);
+        float Soft = Slope * Knee * Knee / (2.0f * KneeL2 + 1.0e-9f);
+        float Hard = Slope * Over;
+        Gain[c] = Mako_FastExp2((Over * 2.0f < -KneeL2) ? 0.0f : ((KneeL2 < Over * 2.0f) ? Hard : Soft));
+    }
+}
 
 
 void MakoBiteAudioProcessor::Mako_Settings_Update(bool ForceAll)
 {
+    MAKO_TRACE_SCOPE("Mako_Settings_Update");
     //R1.00 We do changes here so we know the vars are not in use while we change them.
     //R1.00 EDITOR sets SETTING flags and we make changes here.
     bool Force = ForceAll;
 
-    //R1.00 Update our EQ Filters.
-    Filter_LP_Coeffs(Setting[e_HighCut], &makoF_HighCut);
-    Filter_BP_Coeffs(Setting[e_EQ1], Band1_Freq, Band1_Q, &makoF_Band1);
-    Filter_BP_Coeffs(Setting[e_EQ2], Band2_Freq, Band2_Q, &makoF_Band2);
-    Filter_BP_Coeffs(Setting[e_EQ3], Band3_Freq, Band3_Q, &makoF_Band3);
-    Filter_BP_Coeffs(Setting[e_EQ4], Band4_Freq, Band4_Q, &makoF_Band4);
-    Filter_BP_Coeffs(Setting[e_EQ5], Band5_Freq, Band5_Q, &makoF_Band5);    
+    //R1.02 Only redesign when a setting the filters use has changed. The knob echo after a preset
+    //R1.02 switch, and knobs like Gain or Drive, then cost no coefficient math here.
+    static const int Design_Parms[7] = { e_HighCut, e_EQ, e_EQ1, e_EQ2, e_EQ3, e_EQ4, e_EQ5 };
+    bool Design = Force || (Chain->Design_Rate != Amp_Rate);
+    for (int p : Design_Parms) if (1.0e-4f < std::abs(Setting[p] - Chain->Set[p])) Design = true;
+
+    if (Design)
+    {
+        //R1.00 Update our EQ Filters.
+        Filter_LP_Coeffs(Setting[e_HighCut], &Chain->makoF_HighCut, Amp_Rate);
+        Filter_BP_Coeffs(Setting[e_EQ1], Band1_Freq, Band1_Q, &Chain->makoF_Band1, Amp_Rate);
+        Filter_BP_Coeffs(Setting[e_EQ2], Band2_Freq, Band2_Q, &Chain->makoF_Band2, Amp_Rate);
+        Filter_BP_Coeffs(Setting[e_EQ3], Band3_Freq, Band3_Q, &Chain->makoF_Band3, Amp_Rate);
+        Filter_BP_Coeffs(Setting[e_EQ4], Band4_Freq, Band4_Q, &Chain->makoF_Band4, Amp_Rate);
+        Filter_BP_Coeffs(Setting[e_EQ5], Band5_Freq, Band5_Q, &Chain->makoF_Band5, Amp_Rate);    
+
+        //R1.02 SVF targets. Cheap, the playing filters glide to them.
+        float Freq[5] = { Band1_Freq, Band2_Freq, Band3_Freq, Band4_Freq, Band5_Freq };
+        float Q[5] = { Band1_Q, Band2_Q, Band3_Q, Band4_Q, Band5_Q };
+        Filter_SVF_LP(Setting[e_HighCut], &Chain->makoS_HighCut, Amp_Rate);
+        for (int b = 0; b < 5; b++) Filter_SVF_Bell(Setting[e_EQ1 + b], Freq[b], Q[b], &Chain->makoS_Band[b], Amp_Rate);
+        Chain->Design_Rate = Amp_Rate;
+    }
+
+    //R1.02 The playing chain now sounds like the knobs.
+    for (int t = 0; t < Setting_Max; t++) Chain->Set[t] = Setting[t];
+
+    //R1.02 Let the editor know the response curve changed.
+    if (Design) Mako_Resp_Update();
 
     //R1.00 Set the newly selected IR.
     if ((Setting[e_IR] != Setting_Last[e_IR]) || Force)
     {
         Setting_Last[e_IR] = Setting[e_IR];
-        Mako_IR_Set();
+        Mako_IR_Set(Force);
     }
 
     //R1.00 RESET out settings flags.
@@ -561,14 +1668,44 @@ void MakoBiteAudioProcessor::Mako_Settings_Update(bool ForceAll)
     SettingsChanged = false;
 }
 
+//R1.02 Copy the EQ and High Cut coefficients for the editor. The version is odd while we write.
+void MakoBiteAudioProcessor::Mako_Resp_Update()
+{
+    tp_filter* Filters[6] = { &Chain->makoF_Band1, &Chain->makoF_Band2, &Chain->makoF_Band3, &Chain->makoF_Band4, &Chain->makoF_Band5, &Chain->makoF_HighCut };
+
+    auto Relaxed = std::memory_order_relaxed;
+    Resp_Version.fetch_add(1);
+    for (int f = 0; f < 6; f++)
+    {
+        Resp_Coeffs[f][0].store(Filters[f]->a0, Relaxed);
+        Resp_Coeffs[f][1].store(Filters[f]->a1, Relaxed);
+        Resp_Coeffs[f][2].store(Filters[f]->a2, Relaxed);
+        Resp_Coeffs[f][3].store(Filters[f]->b1, Relaxed);
+        Resp_Coeffs[f][4].store(Filters[f]->b2, Relaxed);
+    }
+    for (int f = 0; f < 5; f++) Resp_Active[f].store(Setting[e_EQ1 + f] != .0f, Relaxed);
+    Resp_Active[5].store(Setting[e_HighCut] < 6000.0f, Relaxed);
+    Resp_SampleRate.store(Amp_Rate, Relaxed);
+    Resp_Version.fetch_add(1, std::memory_order_release);
+}
+
 //R1.01 Apply a 1024 sample Impulse Response to the sample.
-float MakoBiteAudioProcessor::Mako_CabSim(float tSample, int channel)
+template <typename T>
+T MakoBiteAudioProcessor::Mako_CabSim(T tSample, int channel, tp_chain* C, tp_state<T>* S, int samp)
 {
     int T1;
-    float V = 0.0f;
+    T V = 0;
+
+    //R1.02 If the pool did the tail for this block we only need the first Tail_Head taps.
+    //R1.02 While fading between IRs we do both IRs in full.
+    int Slot = Mako_Slot(C);
+    const float* Old = C->IR_Old;
+    bool Tail = Tail_Use[Slot][channel] && (Old == nullptr) && (Cab_Keep == 1024);
+    int Taps = Tail ? Tail_Head : Cab_Keep;
+    T VOld = 0;
     
-    T1 = IRB_Idx[channel];
-    IRB[channel][T1] = tSample;
+    T1 = S->IRB_Idx;
+    S->IRB[T1] = tSample;
 
     //R1.00 Calculate the IR response by multiplying every IR sample by our audio buffer samples.
     //R1.00 Effectively it is a DELAY(comb filter) pedal with 1024 repeats in a very short time.
@@ -576,45 +1713,558 @@ float MakoBiteAudioProcessor::Mako_CabSim(float tSample, int channel)
     //R1.00 The IR acts as both a delay and filter combined.
     //R1.00 For absolute best sound an IR should be 2048 samples. But the IR calc is very heavy on CPU usage.
     //R1.00 Using 1024 here for good sound and less CPU usage. Could add slider and make it even shorter.
-    for (int t = 0; t < 1024; t++)
+    if (Old == nullptr)
     {
-        V += (IR_Final[t] * IRB[channel][T1]);
+        for (int t = 0; t < Taps; t++)
+        {
+            V += (C->IR_Final[t] * S->IRB[T1]);
 
-        //R1.00 Increment index, mask off bits past 1023 to keep our index between 0-1023.
-        //R1.00 IR length must be a power of 2 for masking to work 1024(3FF), 2048(7FF) are standard sizes.
-        T1 = (T1 + 1) & 0x3FF;
+            //R1.00 Increment index, mask off bits past 1023 to keep our index between 0-1023.
+            //R1.00 IR length must be a power of 2 for masking to work 1024(3FF), 2048(7FF) are standard sizes.
+            T1 = (T1 + 1) & 0x3FF;
+        }
+        if (Tail) V += Tail_Jobs[Slot][channel].Out[samp];
+    }
+    else
+    {
+        for (int t = 0; t < Taps; t++)
+        {
+            V += (C->IR_Final[t] * S->IRB[T1]);
+            VOld += (Old[t] * S->IRB[T1]);
+            T1 = (T1 + 1) & 0x3FF;
+        }
+    }
+
+    //R1.02 The governor is fading the end of the IR in or out.
+    if (Cab_Keep < Cab_Taps)
+    {
+        T VEnd = 0;
+        T VOldEnd = 0;
+        for (int t = Cab_Keep; t < Cab_Taps; t++)
+        {
+            VEnd += (C->IR_Final[t] * S->IRB[T1]);
+            if (Old != nullptr) VOldEnd += (Old[t] * S->IRB[T1]);
+            T1 = (T1 + 1) & 0x3FF;
+        }
+
+        float Fade = Cab_Fade0 + (Cab_Fade1 - Cab_Fade0) * juce::jmin(1.0f, float(Cab_FadePos + samp) / float(Preset_FadeLen));
+        V += VEnd * Fade;
+        VOld += VOldEnd * Fade;
     }
     
     //R1.00 Decrement our buffer index and loop around at 0. 
-    IRB_Idx[channel]--;
-    if (IRB_Idx[channel] < 0) IRB_Idx[channel] = 1023;
+    S->IRB_Idx--;
+    if (S->IRB_Idx < 0) S->IRB_Idx = 1023;
+
+    //R1.02 Linear fade. Both IRs see the same signal so their outputs are closely related.
+    if (Old != nullptr)
+    {
+        float Fade = juce::jmin(1.0f, float(C->IR_FadePos + samp) / float(Preset_FadeLen));
+        return (V * C->IR_Final_VolAdjust * Fade) + (VOld * C->IR_OldVol * (1.0f - Fade));
+    }
 
     //R1.00 We usually gain volume here so reduce it.
-    return V * IR_Final_VolAdjust;
+    return V * C->IR_Final_VolAdjust;
 }
 
-//R1.01 Select one of our prestored Impulse responses.
-void MakoBiteAudioProcessor::Mako_IR_Set()
+//R1.02 Use the pool result for this block if it is done and was made for this exact block.
+template <typename T>
+void MakoBiteAudioProcessor::Mako_Tail_Begin(tp_chain* C, int channel, int numSamples)
 {
-    int IR_Model = int(Setting[e_IR]);
+    int Slot = Mako_Slot(C);
+    MakoTailJob* J = &Tail_Jobs[Slot][channel];
+    Tail_Use[Slot][channel] = false;
+
+    int State = J->State.load(std::memory_order_acquire);
+    if (State == MakoTailJob::e_Idle) return;
 
-    //R1.00 Put one of the preset IRs into the actual IR used for processing.
-    switch (IR_Model)
+    bool Ours = (J->Seq == Mako_State<T>(C, channel)->Pos) && (J->IR == C->IR_Final) && (J->Head == Tail_Head) && (numSamples <= J->Len);
+    if (State == MakoTailJob::e_Done)
     {
-        case 1: for (int t = 0; t < 1024; t++) IR_Final[t] = IR_Stored_01[t]; break;
-        case 2: for (int t = 0; t < 1024; t++) IR_Final[t] = IR_Stored_02[t]; break;
-        case 3: for (int t = 0; t < 1024; t++) IR_Final[t] = IR_Stored_03[t]; break;
-        case 4: for (int t = 0; t < 1024; t++) IR_Final[t] = IR_Stored_04[t]; break;
-        default:for (int t = 0; t < 1024; t++) IR_Final[t] = IR_Stored_05[t]; break;
+        Tail_Use[Slot][channel] = Ours;
+        J->State.store(MakoTailJob::e_Idle);
+        return;
     }
 
-    //R1.00 These volumes are estimated in Prepare to play.
+    //R1.02 Late. Cancel it if no worker has started it, and do the whole IR ourselves.
+    if (State == MakoTailJob::e_Queued) J->State.compare_exchange_strong(State, MakoTailJob::e_Idle);
+    else if (State == MakoTailJob::e_Cancelled) J->State.store(MakoTailJob::e_Idle);
+
+    if (J->Seq == Mako_State<T>(C, channel)->Pos)
+    {
+        Tail_Misses.fetch_add(1);
+        if (auto* P = Pool.load(std::memory_order_acquire)) P->Deadline_Misses.fetch_add(1);
+    }
+}
+
+//R1.02 Every block moves both chains' cab positions on, whatever path it took. Eco, a short
+//R1.02 governor IR, IR off or a shut gate then leave nothing a stale pool result could match.
+template <typename T>
+void MakoBiteAudioProcessor::Mako_Tail_Advance(int channel, int numSamples)
+{
+    Mako_State<T>(&Arena->Chain_A, channel)->Pos += numSamples;
+    Mako_State<T>(&Arena->Chain_B, channel)->Pos += numSamples;
+}
+
+//R1.02 Queue the tail of the next block. It only needs the input we already have
+//R1.02 because the next block is never longer than Tail_Head.
+template <typename T>
+void MakoBiteAudioProcessor::Mako_Tail_Post(tp_chain* C, int channel, int numSamples)
+{
+    int Slot = Mako_Slot(C);
+    MakoTailJob* J = &Tail_Jobs[Slot][channel];
+    auto& Ch = *Mako_State<T>(C, channel);
+    MakoPool* P = Pool.load(std::memory_order_acquire);
+    if ((P == nullptr) || (Setting[e_CabPool] < .5f) || (Tail_Head < numSamples)) return;
+
+    //R1.02 A worker still has the last one. It has our buffers so we can not send another.
+    if (J->State.load(std::memory_order_acquire) != MakoTailJob::e_Idle) return;
+
+    //R1.02 Copy the cab input, newest first. The newest sample is just after the write index.
+    //R1.02 The pool works in float, so a double ring is rounded here. Only the tail sees it.
+    int First = (Ch.IRB_Idx + 1) & 0x3FF;
+    if constexpr (std::is_same<T, float>::value)
+    {
+        std::memcpy(J->In, Ch.IRB + First, sizeof(float) * (1024 - First));
+        std::memcpy(J->In + (1024 - First), Ch.IRB, sizeof(float) * First);
+    }
+    else
+    {
+        for (int t = 0; t < 1024; t++) J->In[t] = float(Ch.IRB[(First + t) & 0x3FF]);
+    }
+
+    J->Owner = this;
+    J->IR = C->IR_Final;
+    J->Head = Tail_Head;
+    J->Len = numSamples;
+    J->Seq = Ch.Pos;
+    J->Deadline = juce::Time::getMillisecondCounterHiRes() + (1000.0 * numSamples / SampleRate);
+    J->State.store(MakoTailJob::e_Queued, std::memory_order_release);
+
+    if (! P->Push(J, int((reinterpret_cast<juce::pointer_sized_int>(this) >> 6) & 0xFFFF) + channel)) J->State.store(MakoTailJob::e_Idle);
+}
+
+//R1.01 Select one of our prestored Impulse responses.
+//R1.02 Or a blend of two of them. Now is set when there is no audio running and we can build the blend here.
+void MakoBiteAudioProcessor::Mako_IR_Set(bool Now)
+{
+    MAKO_TRACE_SCOPE("Mako_IR_Set");
+    int IR_Model = juce::jlimit(0, 5, int(Setting[e_IR]));
+    int IR_Model2 = juce::jlimit(0, 5, int(Setting[e_IR2]));
+    float Mix = juce::jlimit(0.0f, 1.0f, Setting[e_IRMix]);
+    Blend_Last[0] = Setting[e_IR2];
+    Blend_Last[1] = Setting[e_IRMix];
+
+    //R1.02 Blending. The builder makes the kernel and Mako_Blend_Poll fades to it.
+    Blend_On = (0 < IR_Model) && (0 < IR_Model2) && (IR_Model != IR_Model2) && (0.0f < Mix);
+    if (Blend_On)
+    {
+        int Request = IR_Model | (IR_Model2 << 3) | (int(Mix * 65535.0f) << 6);
+        if (Now)
+        {
+            Mako_Blend_Build(Request);
+            Mako_Blend_Poll(true);
+        }
+        else
+        {
+            //R1.02 Just post it. Our timer wakes the builder, so the audio thread makes no wake up call.
+            Blend_Request.store(Request);
+        }
+        return;
+    }
+
+    //R1.02 Point at one of the preset IRs. They are read only so nothing needs to be copied.
+    //R1.02 Any kernel still being built is not wanted any more.
+    Blend_Request.store(-1);
+    //R1.00 These volumes are estimated.
     //R1.00 Could do complicated math to get better values. Close enough for us.
-    IR_Final_VolAdjust = IR_VolAdjustVals[IR_Model];
+    Mako_IR_Fade(Chain, IR_Stored_List[IR_Model], IR_Stored_Vol[IR_Model], Now);
 
     return;
 }
 
+//R1.02 Switch the chain to a new IR. Fade from the old one unless Now is set.
+void MakoBiteAudioProcessor::Mako_IR_Fade(tp_chain* C, const float* IR, float Vol, bool Now)
+{
+    if (Now || (C->IR_Final == nullptr) || (C->IR_Final == IR))
+    {
+        C->IR_Final = IR;
+        C->IR_Final_VolAdjust = Vol;
+        C->IR_Old = nullptr;
+        return;
+    }
+
+    C->IR_Old = C->IR_Final;
+    C->IR_OldVol = C->IR_Final_VolAdjust;
+    C->IR_FadePos = 0;
+    C->IR_Final = IR;
+    C->IR_Final_VolAdjust = Vol;
+}
+
+//R1.02 Builder thread (or prepareToPlay). Convolution is linear, so mixing the IRs
+//R1.02 sounds the same as mixing two cabs. The volumes are baked in.
+void MakoBiteAudioProcessor::Mako_Blend_Build(int Request)
+{
+    MAKO_TRACE_SCOPE("Mako_Blend_Build");
+    const juce::ScopedLock Lock(Blend_Lock);
+
+    int A = Request & 7;
+    int B = (Request >> 3) & 7;
+    float Mix = float(Request >> 6) / 65535.0f;
+    float GainA = IR_Stored_Vol[A] * (1.0f - Mix);
+    float GainB = IR_Stored_Vol[B] * Mix;
+
+    float* K = Kernels[Kernel_Back];
+    for (int t = 0; t < 1024; t++) K[t] = (IR_Stored_List[A][t] * GainA) + (IR_Stored_List[B][t] * GainB);
+
+    Kernel_Back = Kernel_Middle.exchange(Kernel_Back | Kernel_New, std::memory_order_acq_rel) & 3;
+}
+
+//R1.02 Audio thread. Take a new kernel if one is ready and nothing else is fading.
+void MakoBiteAudioProcessor::Mako_Blend_Poll(bool Now)
+{
+    if (! Now && ((Chain->IR_Old != nullptr) || (Chain_Old != nullptr))) return;
+    if ((Kernel_Middle.load(std::memory_order_acquire) & Kernel_New) == 0) return;
+
+    //R1.02 The blend may have been turned off while it was being built.
+    if (! Blend_On) return;
+
+    int Fresh = Kernel_Middle.exchange(Kernel_Spare, std::memory_order_acq_rel) & 3;
+    Kernel_Spare = Kernel_Front;
+    Kernel_Front = Fresh;
+    Mako_IR_Fade(Chain, Kernels[Kernel_Front], 1.0f, Now);
+}
+
+void MakoBiteAudioProcessor::tp_builder::run()
+{
+    MAKO_TRACE_THREAD("Mako Builder");
+    while (! threadShouldExit())
+    {
+        int Request = Proc.Blend_Request.exchange(-1);
+        if (Request < 0)
+        {
+            Wake.Wait(Builder_WaitMs);
+            continue;
+        }
+        Proc.Mako_Blend_Build(Request);
+    }
+}
+
+//R1.02 Fit the eco cab for every IR Model at our sample rate.
+void MakoBiteAudioProcessor::Mako_Eco_Fit()
+{
+    MAKO_TRACE_SCOPE("Mako_Eco_Fit");
+    auto T0 = juce::Time::getHighResolutionTicks();
+    for (int m = 1; m < 6; m++) Mako_Eco_FitModel(m);
+
+    //R1.02 IR Model 0 is off, but uses the same stored IR as Model 5.
+    for (int b = 0; b < Eco_Bands; b++) Eco_Coeffs[0][b] = Eco_Coeffs[5][b];
+    Eco_Gain[0] = Eco_Gain[5];
+    Eco_Error_dB[0] = Eco_Error_dB[5];
+    Eco_ErrorMax_dB[0] = Eco_ErrorMax_dB[5];
+
+    Eco_FitRate = SampleRate;
+    Eco_Fit_mS = 1000.0 * juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - T0);
+}
+
+//R1.02 Greedy fit. Measure the IR at Eco_Points log spaced frequencies. Fit a low pass and a high pass
+//R1.02 for the speaker roll offs, then keep adding the peaking filter that best removes the biggest error.
+//R1.02 Then refit each peaking filter with the others in place.
+//R1.02 Anything more than 40dB below the loudest point is treated as 40dB down. We can not hear the difference
+//R1.02 and chasing deep notches wastes filters.
+void MakoBiteAudioProcessor::Mako_Eco_FitModel(int Model)
+{
+    const float* IR = IR_Stored_List[Model];
+    float FMax = juce::jmin(16000.0f, .45f * SampleRate);
+    float W[Eco_Points];                    //R1.02 Frequency in radians per sample.
+    float Target[Eco_Points];               //R1.02 IR response in dB.
+    float Model_dB[Eco_Points] = {};
+    float Band_dB[Eco_Bands][Eco_Points];
+    float Band_Fc[Eco_Bands];
+    tp_filter Band[Eco_Bands] = {};
+    const float Qs[7] = { .5f, .707f, 1.0f, 1.414f, 2.0f, 3.0f, 4.0f };
+
+    for (int p = 0; p < Eco_Points; p++)
+    {
+        float Fc = 40.0f * powf(FMax / 40.0f, float(p) / float(Eco_Points - 1));
+        W[p] = pi2 * Fc / SampleRate;
+
+        //R1.02 DFT of the IR at this one frequency.
+        double Re = 0.0;
+        double Im = 0.0;
+        for (int t = 0; t < 1024; t++)
+        {
+            Re += IR[t] * cos(double(W[p]) * t);
+            Im -= IR[t] * sin(double(W[p]) * t);
+        }
+        Target[p] = 20.0f * log10f(float(sqrt(Re * Re + Im * Im)) * IR_Stored_Vol[Model] + 1e-9f);
+    }
+
+    float Peak = Target[0];
+    for (int p = 1; p < Eco_Points; p++) Peak = juce::jmax(Peak, Target[p]);
+    for (int p = 0; p < Eco_Points; p++) Target[p] = juce::jmax(Target[p], Peak - 40.0f);
+
+    //R1.02 dB response of a biquad at every fit frequency.
+    auto Response = [&](const tp_filter& f, float* Out)
+    {
+        for (int p = 0; p < Eco_Points; p++)
+        {
+            std::complex<float> z1 = std::polar(1.0f, -W[p]);
+            std::complex<float> z2 = z1 * z1;
+            std::complex<float> H = (f.a0 + f.a1 * z1 + f.a2 * z2) / (1.0f + f.b1 * z1 + f.b2 * z2);
+            Out[p] = 20.0f * log10f(std::abs(H) + 1e-9f);
+        }
+    };
+
+    //R1.02 Best Q for a filter at point p that removes Residual. Returns the squared error.
+    auto FitBand = [&](int b, int p, const float* Residual)
+    {
+        float Best = 1e30f;
+        float Fc = W[p] * SampleRate / pi2;
+        tp_filter Try = {};
+        float Try_dB[Eco_Points];
+        for (float Q : Qs)
+        {
+            for (float Scale = .8f; Scale < 1.3f; Scale += .2f)
+            {
+                Filter_BP_Coeffs(juce::jlimit(-24.0f, 24.0f, Residual[p] * Scale), Fc, Q, &Try, SampleRate);
+                Response(Try, Try_dB);
+
+                float Err = 0.0f;
+                for (int t = 0; t < Eco_Points; t++) Err += (Residual[t] - Try_dB[t]) * (Residual[t] - Try_dB[t]);
+                if (Err < Best)
+                {
+                    Best = Err;
+                    Band[b] = Try;
+                    Band_Fc[b] = Fc;
+                    for (int t = 0; t < Eco_Points; t++) Band_dB[b][t] = Try_dB[t];
+                }
+            }
+        }
+        return Best;
+    };
+
+    //R1.02 Overall gain is the average of what is left.
+    auto Offset = [&]()
+    {
+        float Sum = 0.0f;
+        for (int p = 0; p < Eco_Points; p++) Sum += Target[p] - Model_dB[p];
+        return Sum / float(Eco_Points);
+    };
+
+    float Residual[Eco_Points];
+    float Gain_dB = Offset();
+
+    //R1.02 Band 0 is a low pass and band 1 a high pass. Try every fit frequency in their range.
+    for (int b = 0; b < 2; b++)
+    {
+        float Best = 1e30f;
+        tp_filter Try = {};
+        float Try_dB[Eco_Points];
+        for (int p = 0; p < Eco_Points; p++)
+        {
+            float Fc = W[p] * SampleRate / pi2;
+            if ((b == 0) && (Fc < 1500.0f)) continue;
+            if ((b == 1) && (400.0f < Fc)) break;
+
+            if (b == 0) Filter_LP_Coeffs(Fc, &Try, SampleRate);
+            else Filter_HP_Coeffs(Fc, &Try, SampleRate);
+            Response(Try, Try_dB);
+
+            float Sum = 0.0f;
+            for (int t = 0; t < Eco_Points; t++) Sum += Target[t] - Model_dB[t] - Try_dB[t];
+            float Off = Sum / float(Eco_Points);
+
+            float Err = 0.0f;
+            for (int t = 0; t < Eco_Points; t++)
+            {
+                float e = Target[t] - Model_dB[t] - Try_dB[t] - Off;
+                Err += e * e;
+            }
+            if (Err < Best)
+            {
+                Best = Err;
+                Band[b] = Try;
+                Band_Fc[b] = Fc;
+                for (int t = 0; t < Eco_Points; t++) Band_dB[b][t] = Try_dB[t];
+            }
+        }
+
+        for (int p = 0; p < Eco_Points; p++) Model_dB[p] += Band_dB[b][p];
+        Gain_dB = Offset();
+    }
+
+    //R1.02 Add peaking filters one at a time where the error is biggest.
+    for (int b = 2; b < Eco_Bands; b++)
+    {
+        int Worst = 0;
+        for (int p = 0; p < Eco_Points; p++)
+        {
+            Residual[p] = Target[p] - Model_dB[p] - Gain_dB;
+            if (fabsf(Residual[Worst]) < fabsf(Residual[p])) Worst = p;
+        }
+
+        FitBand(b, Worst, Residual);
+        for (int p = 0; p < Eco_Points; p++) Model_dB[p] += Band_dB[b][p];
+        Gain_dB = Offset();
+    }
+
+    //R1.02 Refit each filter near its frequency with all the others in place.
+    for (int Pass = 0; Pass < 2; Pass++)
+    {
+        for (int b = 2; b < Eco_Bands; b++)
+        {
+            for (int p = 0; p < Eco_Points; p++)
+            {
+                Model_dB[p] -= Band_dB[b][p];
+                Residual[p] = Target[p] - Model_dB[p] - Gain_dB;
+            }
+
+            int Near = 0;
+            for (int p = 0; p < Eco_Points; p++)
+                if (fabsf(W[p] - pi2 * Band_Fc[b] / SampleRate) < fabsf(W[Near] - pi2 * Band_Fc[b] / SampleRate)) Near = p;
+
+            float Best = 1e30f;
+            int BestP = Near;
+            for (int p = juce::jmax(0, Near - 2); p <= juce::jmin(Eco_Points - 1, Near + 2); p++)
+            {
+                float Err = FitBand(b, p, Residual);
+                if (Err < Best)
+                {
+                    Best = Err;
+                    BestP = p;
+                }
+            }
+            FitBand(b, BestP, Residual);
+
+            for (int p = 0; p < Eco_Points; p++) Model_dB[p] += Band_dB[b][p];
+            Gain_dB = Offset();
+        }
+    }
+
+    //R1.02 Report how close we got.
+    float Sum = 0.0f;
+    float Max = 0.0f;
+    for (int p = 0; p < Eco_Points; p++)
+    {
+        float Err = fabsf(Target[p] - Model_dB[p] - Gain_dB);
+        Sum += Err * Err;
+        Max = juce::jmax(Max, Err);
+    }
+    Eco_Error_dB[Model] = sqrtf(Sum / float(Eco_Points));
+    Eco_ErrorMax_dB[Model] = Max;
+
+    for (int b = 0; b < Eco_Bands; b++) Eco_Coeffs[Model][b] = Band[b];
+    Eco_Gain[Model] = powf(10.0f, Gain_dB / 20.0f);
+}
+
+//R1.02 Point the chain at the eco filters for its IR. History is cleared when the IR changes.
+void MakoBiteAudioProcessor::Mako_Eco_Load(tp_chain* C)
+{
+    int Model = juce::jlimit(0, 5, int(C->Set[e_IR]));
+    if (C->Eco_Model == Model) return;
+
+    int Slot = Mako_Slot(C);
+    Mako_State_All([Slot](auto& S, int c) { if (c == Slot) for (auto& E : S.Eco) E = {}; });
+    C->Eco_Model = Model;
+}
+
+//R1.02 Eco cab. 12 biquads instead of 1024 taps.
+template <typename T>
+T MakoBiteAudioProcessor::Mako_CabEco(T tSample, tp_chain* C, tp_state<T>* S)
+{
+    T tS = tSample;
+    const tp_filter* F = Eco_Coeffs[C->Eco_Model];
+    for (int b = 0; b < Eco_Bands; b++) tS = Filter_Calc_BiQuad(tS, F[b], S->Eco[b]);
+
+    return tS * Eco_Gain[C->Eco_Model];
+}
+
+//R1.02 Calc everything a preset needs at amp rate Fs. Only called from Mako_Profile_Design.
+void MakoBiteAudioProcessor::Mako_Preset_Design(tp_preset* P, const float* Values, float Fs)
+{
+    float Freq[5];
+    float Q[5];
+    tp_filter* Bands = P->makoF_Band;
+
+    for (int t = 0; t < Setting_Max; t++) P->Set[t] = (t < Parm_Knob_Cnt) ? Values[t] : 0.0f;
+
+    Filter_LP_Coeffs(P->Set[e_HighCut], &P->makoF_HighCut, Fs);
+    Mako_Band_GetValues(int(P->Set[e_EQ]), Freq, Q);
+    for (int b = 0; b < 5; b++) Filter_BP_Coeffs(P->Set[e_EQ1 + b], Freq[b], Q[b], &Bands[b], Fs);
+    Filter_SVF_LP(P->Set[e_HighCut], &P->makoS_HighCut, Fs);
+    for (int b = 0; b < 5; b++) Filter_SVF_Bell(P->Set[e_EQ1 + b], Freq[b], Q[b], &P->makoS_Band[b], Fs);
+
+    int IR_Model = juce::jlimit(0, 5, int(P->Set[e_IR]));
+    P->IR_Final = IR_Stored_List[IR_Model];
+    P->IR_Final_VolAdjust = IR_Stored_Vol[IR_Model];
+}
+
+//R1.02 Copy a preset into a chain. Coefficients only, the filter history is kept.
+void MakoBiteAudioProcessor::Mako_Preset_Load(tp_chain* C, const tp_preset* P)
+{
+    tp_filter* Dest[6] = { &C->makoF_Band1, &C->makoF_Band2, &C->makoF_Band3, &C->makoF_Band4, &C->makoF_Band5, &C->makoF_HighCut };
+    const tp_filter* Src[6] = { &P->makoF_Band[0], &P->makoF_Band[1], &P->makoF_Band[2], &P->makoF_Band[3], &P->makoF_Band[4], &P->makoF_HighCut };
+
+    for (int f = 0; f < 6; f++) *Dest[f] = *Src[f];
+    C->makoS_HighCut = P->makoS_HighCut;
+    for (int b = 0; b < 5; b++) C->makoS_Band[b] = P->makoS_Band[b];
+
+    C->IR_Final = P->IR_Final;
+    C->IR_Final_VolAdjust = P->IR_Final_VolAdjust;
+    C->IR_Old = nullptr;
+    C->Design_Rate = Amp_Rate;
+    for (int t = 0; t < Parm_Knob_Cnt; t++) C->Set[t] = P->Set[t];
+}
+
+//R1.02 Audio thread. Load the preset into the spare chain and start fading to it.
+//R1.02 No coefficient math and no allocation, just copies.
+void MakoBiteAudioProcessor::Mako_Preset_Switch(int Index)
+{
+    MAKO_TRACE_SCOPE("Mako_Preset_Switch");
+    if ((Index < 0) || (Preset_Cnt <= Index)) return;
+
+    tp_chain* Next = (Chain == &Arena->Chain_A) ? &Arena->Chain_B : &Arena->Chain_A;
+
+    //R1.02 Start from the playing chain so the new one has warm filter and IR history.
+    *Next = *Chain;
+    //R1.02 Only the set for the host's sample type is playing.
+    int To = Mako_Slot(Next);
+    int From = Mako_Slot(Chain);
+    for (int ch = 0; ch < 2; ch++)
+    {
+        if (isUsingDoublePrecision()) Arena->State_d[To][ch] = Arena->State_d[From][ch];
+        else Arena->State[To][ch] = Arena->State[From][ch];
+    }
+    Mako_Preset_Load(Next, &Profile->Presets[Index]);
+    float IR_Was = Setting[e_IR];
+
+    //R1.02 Our knobs follow the preset.
+    for (int t = 0; t < Parm_Knob_Cnt; t++) Setting[t] = Profile->Presets[Index].Set[t];
+    Setting_Last[e_IR] = Setting[e_IR];
+    Mako_Band_SetFilterValues();
+
+    Chain_Old = Chain;
+    Chain = Next;
+    Preset_FadePos = 0;
+
+    //R1.02 IR 2 and IR Mix are not in presets, so a blend carries on. The same cab keeps the built
+    //R1.02 kernel, a new one asks the builder for its blend and fades to it after this fade.
+    if (Blend_On)
+    {
+        if (Setting[e_IR] == IR_Was)
+        {
+            Next->IR_Final = Chain_Old->IR_Final;
+            Next->IR_Final_VolAdjust = Chain_Old->IR_Final_VolAdjust;
+        }
+        else Mako_IR_Set(false);
+    }
+    Mako_Resp_Update();
+
+    Preset_Current.store(Index);
+    Preset_Switches.fetch_add(1, std::memory_order_release);
+}
+
 //R1.01 Possible clipping method. Not used. 
 float MakoBiteAudioProcessor::Mako_FX_AngleClip(float tSample)
 {
@@ -627,169 +2277,60 @@ float MakoBiteAudioProcessor::Mako_FX_AngleClip(float tSample)
     return tS;
 }
 
-//R1.01 Select the EQ frequencies and Qs. Must match the editor code.
+//R1.01 Select the EQ frequencies and Qs. The editor labels come from the same table.
 void MakoBiteAudioProcessor::Mako_Band_SetFilterValues()
 {
-    int EQ_Mode = int(Setting[e_EQ]);
-
-    //R1.01 Define the user selected EQ mode.
-    switch (EQ_Mode)
-    {
-    default:
-    {
-        Band1_Freq = 150.0f;
-         Band2_Freq = 300.0f;
-         Band3_Freq = 750.0f;
-         Band4_Freq = 1500.0f;
-         Band5_Freq = 3000.0f;
-         Band1_Q = .707f;
-         Band2_Q = 1.414f;
-         Band3_Q = 1.414f;
-         Band4_Q = 1.414f;
-         Band5_Q = 1.414f;
-        break;
-    }
-    case 1:
-    {
-         Band1_Freq = 150.0f;
-         Band2_Freq = 450.0f;
-         Band3_Freq = 900.0f;
-         Band4_Freq = 1800.0f;
-         Band5_Freq = 3500.0f;
-         Band1_Q = .707f;
-         Band2_Q = 1.414f;
-         Band3_Q = 1.414f;
-         Band4_Q = 1.414f;
-         Band5_Q = 1.414f;
-        break;
-    }
-    case 2:
-    {
-         Band1_Freq = 80.0f;
-         Band2_Freq = 220.0f;
-         Band3_Freq = 750.0f;
-         Band4_Freq = 2200.0f;
-         Band5_Freq = 6000.0f;
-         Band1_Q = .707f;
-         Band2_Q = 1.414f;
-         Band3_Q = 1.414f;
-         Band4_Q = 1.414f;
-         Band5_Q = 1.414f;
-        break;
-    }
-    case 3:
-    {
-         Band1_Freq = 80.0f;
-         Band2_Freq = 350.0f;
-         Band3_Freq = 900.0f;
-         Band4_Freq = 1500.0f;
-         Band5_Freq = 3000.0f;
-         Band1_Q = .707f;
-         Band2_Q = 1.414f;
-         Band3_Q = 1.414f;
-         Band4_Q = 1.414f;
-         Band5_Q = 1.414f;
-        break;
-    }
-    case 4:
-    {
-         Band1_Freq = 100.0f;
-         Band2_Freq = 400.0f;
-         Band3_Freq = 800.0f;
-         Band4_Freq = 1600.0f;
-         Band5_Freq = 3200.0f;
-         Band1_Q = .707f;
-         Band2_Q = 1.414f;
-         Band3_Q = 1.414f;
-         Band4_Q = 1.414f;
-         Band5_Q = 1.414f;
-        break;
-    }
-    case 5:
-    {
-         Band1_Freq = 120.0f;
-         Band2_Freq = 330.0f;
-         Band3_Freq = 660.0f;
-         Band4_Freq = 1320.0f;
-         Band5_Freq = 2500.0f;
-         Band1_Q = .707f;
-         Band2_Q = 1.414f;
-         Band3_Q = .707f;
-         Band4_Q = 1.414f;
-         Band5_Q = .707f;
-        break;
-    }
-    case 6:
-    {
-         Band1_Freq = 150.0f;
-         Band2_Freq = 500.0f;
-         Band3_Freq = 900.0f;
-         Band4_Freq = 1800.0f;
-         Band5_Freq = 5000.0f;
-         Band1_Q = 1.414f;
-         Band2_Q = .707f;
-         Band3_Q = 1.414f;
-         Band4_Q = 1.414f;
-         Band5_Q = .707f;
-        break;
-    }
-    case 7:
-    {
-         Band1_Freq = 80.0f;
-         Band2_Freq = 300.0f;
-         Band3_Freq = 650.0f;
-         Band4_Freq = 1500.0f;
-         Band5_Freq = 5000.0f;
-         Band1_Q = 1.414f;
-         Band2_Q = .707f;
-         Band3_Q = 2.00f;
-         Band4_Q = 1.414f;
-         Band5_Q = .707f;
-        break;
-    }
-    case 8:
-    {
-         Band1_Freq = 100.0f;
-         Band2_Freq = 400.0f;
-         Band3_Freq = 800.0f;
-         Band4_Freq = 1500.0f;
-         Band5_Freq = 5000.0f;
-         Band1_Q = .707f;
-         Band2_Q = .707f;
-         Band3_Q = 1.414f;
-         Band4_Q = 2.00f;
-         Band5_Q = .35f;
-        break;
-    }
-    case 9:
-    {
-         Band1_Freq = 80.0f;
-         Band2_Freq = 500.0f;
-         Band3_Freq = 1000.0f;
-         Band4_Freq = 2000.0f;
-         Band5_Freq = 5000.0f;
-         Band1_Q = .707f;
-         Band2_Q = 1.414f;
-         Band3_Q = .707f;
-         Band4_Q = .707f;
-         Band5_Q = .350f;
-        break;
-    }
-    case 10:
-    {
-         Band1_Freq = 80.0f;
-         Band2_Freq = 250.0f;
-         Band3_Freq = 750.0f;
-         Band4_Freq = 1800.0f;
-         Band5_Freq = 5000.0f;
-         Band1_Q = 2.000f;
-         Band2_Q = .707f;
-         Band3_Q = 2.00f;
-         Band4_Q = 1.414f;
-         Band5_Q = .350f;
-        break;
-    }
+    float Freq[5];
+    float Q[5];
+    Mako_Band_GetValues(int(Setting[e_EQ]), Freq, Q);
+
+    Band1_Freq = Freq[0];
+    Band2_Freq = Freq[1];
+    Band3_Freq = Freq[2];
+    Band4_Freq = Freq[3];
+    Band5_Freq = Freq[4];
+    Band1_Q = Q[0];
+    Band2_Q = Q[1];
+    Band3_Q = Q[2];
+    Band4_Q = Q[3];
+    Band5_Q = Q[4];
+}
 
+//R1.02 EQ mode frequencies and Qs. Table form so presets can be designed without touching Band*_Freq.
+void MakoBiteAudioProcessor::Mako_Band_GetValues(int EQ_Mode, float* Freq, float* Q)
+{
+    static const float Band_Freq[11][5] = {
+        { 150.0f, 300.0f,  750.0f, 1500.0f, 3000.0f },
+        { 150.0f, 450.0f,  900.0f, 1800.0f, 3500.0f },
+        {  80.0f, 220.0f,  750.0f, 2200.0f, 6000.0f },
+        {  80.0f, 350.0f,  900.0f, 1500.0f, 3000.0f },
+        { 100.0f, 400.0f,  800.0f, 1600.0f, 3200.0f },
+        { 120.0f, 330.0f,  660.0f, 1320.0f, 2500.0f },
+        { 150.0f, 500.0f,  900.0f, 1800.0f, 5000.0f },
+        {  80.0f, 300.0f,  650.0f, 1500.0f, 5000.0f },
+        { 100.0f, 400.0f,  800.0f, 1500.0f, 5000.0f },
+        {  80.0f, 500.0f, 1000.0f, 2000.0f, 5000.0f },
+        {  80.0f, 250.0f,  750.0f, 1800.0f, 5000.0f },
+    };
+    static const float Band_Q[11][5] = {
+        {  .707f, 1.414f, 1.414f, 1.414f, 1.414f },
+        {  .707f, 1.414f, 1.414f, 1.414f, 1.414f },
+        {  .707f, 1.414f, 1.414f, 1.414f, 1.414f },
+        {  .707f, 1.414f, 1.414f, 1.414f, 1.414f },
+        {  .707f, 1.414f, 1.414f, 1.414f, 1.414f },
+        {  .707f, 1.414f,  .707f, 1.414f,  .707f },
+        { 1.414f,  .707f, 1.414f, 1.414f,  .707f },
+        { 1.414f,  .707f, 2.000f, 1.414f,  .707f },
+        {  .707f,  .707f, 1.414f, 2.000f,  .350f },
+        {  .707f, 1.414f,  .707f,  .707f,  .350f },
+        { 2.000f,  .707f, 2.000f, 1.414f,  .350f },
+    };
+
+    //R1.01 Anything out of range uses the default mode.
+    if ((EQ_Mode < 0) || (10 < EQ_Mode)) EQ_Mode = 0;
+    for (int b = 0; b < 5; b++)
+    {
+        Freq[b] = Band_Freq[EQ_Mode][b];
+        Q[b] = Band_Q[EQ_Mode][b];
     }
-
 }
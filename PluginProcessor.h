@@ -9,11 +9,23 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "PluginIRs.h"      //R1.02 Our stored IRs.
+#include "PluginPool.h"     //R1.02 Worker pool shared by all instances.
+
+//R1.02 Lock the DSP state arena in RAM in prepareToPlay. Set to 0 to leave it pageable.
+#ifndef MAKO_LOCK_ARENA
+ #define MAKO_LOCK_ARENA 1
+#endif
+
+//R1.02 Samples per control rate step for the gate and compressor. 1 to 64.
+#ifndef MAKO_CTRL_RATE
+ #define MAKO_CTRL_RATE 16
+#endif
 
 //==============================================================================
 /**
 */
-class MakoBiteAudioProcessor  : public juce::AudioProcessor
+class MakoBiteAudioProcessor  : public juce::AudioProcessor , private juce::Timer
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -26,12 +38,15 @@ public:
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void setNonRealtime (bool isNonRealtime) noexcept override;     //R1.02 Added.
 
    #ifndef JucePlugin_PreferredChannelConfigurations
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;    //R1.02 64 bit hosts.
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -52,6 +67,19 @@ public:
     const juce::String getProgramName (int index) override;
     void changeProgramName (int index, const juce::String& newName) override;
 
+    //R1.02 Message thread. Show a preset the audio thread switched to in the host and editor.
+    //R1.02 Called by our timer, or directly by tools that have no message loop.
+    void Mako_Preset_Follow();
+
+    //R1.02 Message thread. Start the helper threads a setting has just turned on. Timer or tools, like above.
+    void Mako_Threads_Follow();
+
+    //R1.02 Message thread. Redesign the offline profile when Offline HQ changes and report the latency.
+    void Mako_Profile_Follow();
+
+    //R1.02 EQ mode band frequencies and Qs. The editor labels use it too.
+    static void Mako_Band_GetValues(int EQ_Mode, float* Freq, float* Q);
+
     //==============================================================================
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -61,16 +89,11 @@ public:
     
     int SettingsChanged = 0;
     int SettingsType = 0;
-    float Setting[30] = {};
-    float Setting_Last[30] = {};
+    static const int Setting_Max = 40;       //R1.02 Room for parameters. Parm_Cnt must not pass this.
+    float Setting[Setting_Max] = {};
+    float Setting_Last[Setting_Max] = {};
 
     //R1.00 Our public variables.
-    float Pedal_NGate_Fac[2] = {};    //R1.00 Noise Gate.
-    float Signal_AVG[2] = {};       
-    
-    float Pedal_CompGain[2] = {};     //R1.00 Compressor vars.
-    float Pedal_CompGainAdj[2] = {};
-
     //int Pedal_Band = 0;
     float Pedal_Band1 = 0.0f;
     float Pedal_Band2 = 0.0f;
@@ -89,6 +112,53 @@ public:
     float Band3_Q = 1.414f;
     float Band4_Q = 1.414f;
     float Band5_Q = 1.414f;
+
+    //R1.02 Parameter IDs in the same order as our Setting[] indexes.
+    //R1.02 Lets tools and hosts update Setting[] without the editor being open.
+    static const char* const Parm_IDs[];
+    static const int Parm_Cnt = 32;
+    static const int Parm_Knob_Cnt = 17;   //R1.02 Parameters past this have no knob and are read from the host each block.
+    void Mako_Settings_FromParameters();
+
+    //R1.02 Clear all of the filter, IR, and effect history. Called in prepareToPlay.
+    void Mako_Reset_State();
+
+    //R1.02 SCOPE - The audio thread writes every 2nd input and output sample into lock free FIFOs,
+    //R1.02 but only while an editor has Scope_Active set. The editor reads them on its timer.
+    //R1.02 4096 is 170mS at 48k, several 30Hz editor ticks. Anything that does not fit is dropped.
+    static const int Scope_Size = 4096;
+    std::atomic<bool> Scope_Active { false };
+    std::atomic<float> Scope_SampleRate { 24000.0f };
+    int Mako_Scope_Pull(float* In, float* Out, int Max);
+
+    //R1.02 Copy of the EQ band and High Cut coefficients (a0,a1,a2,b1,b2) for the editor response curve.
+    //R1.02 Resp_Version is odd while the audio thread is changing them. The values are atomics
+    //R1.02 (relaxed) so a copy racing a change is only thrown away, never undefined.
+    std::atomic<int> Resp_Version { 0 };
+    std::atomic<float> Resp_Coeffs[6][5] = {};
+    std::atomic<bool> Resp_Active[6] = {};
+    std::atomic<float> Resp_SampleRate { 48000.0f };
+
+    //R1.02 CAB POOL counters. Jobs waiting in the shared pool and results that were late.
+    std::atomic<int> Tail_Misses { 0 };
+    int Mako_Pool_QueueDepth() const { auto* P = Pool.load(); return (P == nullptr) ? 0 : P->Queue_Depth.load(); }
+    int Mako_Pool_Misses() const { auto* P = Pool.load(); return (P == nullptr) ? 0 : P->Deadline_Misses.load(); }
+
+    //R1.02 ECO CAB fit error against the full IR by IR Model. RMS and worst case dB, 40Hz to 16kHz.
+    //R1.02 Filled in the first time Eco Cab is on at a sample rate, with the time the fit took.
+    float Eco_Error_dB[6] = {};
+    float Eco_ErrorMax_dB[6] = {};
+    double Eco_Fit_mS = 0.0;
+
+    //R1.02 OFFLINE HQ - True while a bounce is using the offline profile, even with Offline HQ off.
+    std::atomic<bool> Offline_Active { false };
+
+    //R1.02 GOVERNOR - Quality level the CPU governor has us at. 0 is full quality.
+    static const int Gov_Levels = 5;
+    std::atomic<int> Gov_Level_Now { 0 };
+
+    //R1.02 Tools only. Pin the governor at a level whatever the load, -1 goes back to following the load.
+    void Mako_Gov_Force(int Level) { Gov_Force.store(Level); }
         
 
 private:
@@ -96,25 +166,84 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MakoBiteAudioProcessor)
    
     //R1.00 These are the indexes into our Settings var.
-    enum { e_Gain, e_NGate, e_Drive, e_Comp, e_EQ, e_EQ1, e_EQ2, e_EQ3, e_EQ4, e_EQ5, e_IR, e_Bottom, e_Mono, e_HighCut, e_Sag, e_Asym, e_LowCut };
+    enum { e_Gain, e_NGate, e_Drive, e_Comp, e_EQ, e_EQ1, e_EQ2, e_EQ3, e_EQ4, e_EQ5, e_IR, e_Bottom, e_Mono, e_HighCut, e_Sag, e_Asym, e_LowCut,
+           e_CompAtk, e_CompRel, e_CompRatio, e_CompKnee, e_CompRMS, e_CompLink, e_MultiCore, e_CabPool, e_IR2, e_IRMix, e_Eco, e_Offline, e_Governor, e_ADAA, e_SVF };
 
     //R1.00 Clean up the parameter reading code.
     int Mako_GetParmValue_int(juce::String Pstring);
     float Mako_GetParmValue_float(juce::String Pstring);
 
+    //R1.02 Raw parameter values found once in the constructor so we dont search by name later.
+    std::atomic<float>* Parm_Value[Setting_Max] = {};
+    juce::RangedAudioParameter* Parm_Object[Setting_Max] = {};
+
+    //R1.02 Binary state header. 'MKRS', then the format version.
+    static const int State_Tag = 0x53524B4D;
+    static const int State_Version = 1;
+
     //R1.00 Handle parameter changes made in editor.
     void Mako_Settings_Update(bool ForceAll);
     void Mako_Band_SetFilterValues();
 
     //R1.00 Our actual AUDIO adjusting functions.
-    float Mako_FX_NoiseGate(float tSample, int channel);
-    float Mako_FX_Compressor(float tSample, int channel);
-    float Mako_FX_AmpSim(float tSample, int channel);
-    void Mako_IR_Set();
+    //R1.02 Templated on the sample type so float and double hosts share the same code.
+    template <typename T> void Mako_Process(juce::AudioBuffer<T>& buffer, juce::MidiBuffer& midiMessages);
+    void Mako_Comp_SetTimes();
+    void Mako_IR_Set(bool Now);
     float Mako_FX_AngleClip(float tSample);
 
-    //R1.01 Sag sample storage.
-    float Sag_Last[2] = {};
+    //R1.02 CONTROL RATE - Gain stages that change slowly work out one gain every Ctrl_Rate samples
+    //R1.02 from a detector for that period, and the scheduler ramps between the gains at audio rate.
+    //R1.02 A new stage registers a Tick and an On test at one of the points in the chain.
+    static const int Ctrl_Max = 64;
+    static_assert((1 <= MAKO_CTRL_RATE) && (MAKO_CTRL_RATE <= Ctrl_Max), "MAKO_CTRL_RATE must be 1 to 64");
+    int Ctrl_Rate = MAKO_CTRL_RATE;
+    enum { e_CtrlPre, e_CtrlPost, e_CtrlPoints };      //R1.02 Before the amp (one channel) and after the cab (all channels).
+
+    struct tp_ctrlin {                                  //R1.02 Detector for one period of one channel.
+        float Peak;
+        float MeanAbs;
+        float MeanSq;
+        int Len;
+    };
+    typedef void (MakoBiteAudioProcessor::*tp_ctrltick)(const tp_ctrlin* In, int Ch0, int numChannels, float* Gain);
+    typedef bool (MakoBiteAudioProcessor::*tp_ctrlon)() const;
+    struct tp_ctrlstage {
+        const char* Name;
+        tp_ctrltick Tick;
+        tp_ctrlon On;
+    };
+    struct tp_ctrlpoint {
+        tp_ctrlstage Stages[4];
+        int Cnt = 0;
+    };
+    tp_ctrlpoint Ctrl_Points[e_CtrlPoints];
+    void Mako_Ctrl_Register(int Point, const char* Name, tp_ctrltick Tick, tp_ctrlon On);
+    template <typename T> bool Mako_Ctrl_Run(int Point, T* const* Data, int Ch0, int numChannels, int numSamples);
+
+    //R1.02 Noise gate settings. The gate state is in the arena.
+    bool Mako_Gate_On() const;
+    void Mako_Gate_Tick(const tp_ctrlin* In, int Ch0, int numChannels, float* Gain);
+    float Gate_EnvPow[Ctrl_Max + 1] = {};  //R1.02 Gate_EnvCoef to the power of n.
+    float Gate_EnvCoef = .995f;
+    float Gate_AttackStep = 0.0f;
+    float Gate_ReleaseStep = 0.0f;
+    int Gate_HoldSamples = 0;
+    int Gate_TailSamples = 0;       //R1.02 How long the amp, cab and comp take to go quiet.
+
+    //R1.02 Compressor. The detector level is in the arena. Runs at the control rate.
+    bool Mako_Comp_On() const;
+    void Mako_Comp_Tick(const tp_ctrlin* In, int Ch0, int numChannels, float* Gain);
+    float Comp_AtkCoef = 0.0f;
+    float Comp_RelCoef = 0.0f;
+
+    //R1.02 Scope FIFOs. Single writer (audio thread), single reader (editor).
+    juce::AbstractFifo Scope_FifoIn { Scope_Size };
+    juce::AbstractFifo Scope_FifoOut { Scope_Size };
+    float Scope_DataIn[Scope_Size];                //R1.02 Not cleared. Always written before they are read.
+    float Scope_DataOut[Scope_Size];
+    template <typename T> void Mako_Scope_Push(juce::AbstractFifo& Fifo, float* Store, const T* Data, int numSamples);
+    void Mako_Resp_Update();
 
     //R1.00 Some Constants and vars.
     const float pi = 3.14159265f;
@@ -130,603 +259,348 @@ private:
     float Release_500mS = 0.0f;
 
     //R1.00 OUR FILTER VARIABLES
-    struct tp_coeffs {
+    //R1.02 Coefficients only. The history lives in the arena so coefficients can be shared and copied freely.
+    struct tp_filter {
         float a0;
         float a1;
         float a2;
         float b1;
         float b2;
+    };
+
+    //R1.02 History is the sample type, so a 64 bit host keeps every bit thru the filters.
+    template <typename T>
+    struct tp_history {
+        T xn1;
+        T xn2;
+        T yn1;
+        T yn2;
+    };
+
+    //R1.02 SVF - TPT state variable filter targets. Out = c0 * In + c1 * Band + c2 * Low.
+    //R1.02 Same responses as the biquads, but safe to change every sample.
+    struct tp_svf {
+        float g;
+        float k;
         float c0;
-        float d0;
+        float c1;
+        float c2;
     };
 
-    struct tp_filter {
-        float a0;
+    //R1.02 SVF state. g, k and c1 glide to the targets. a1 follows g and k.
+    template <typename T>
+    struct tp_svfstate {
+        T ic1;
+        T ic2;
+        float g;
+        float k;
+        float c1;
         float a1;
-        float a2;
-        float b1;
-        float b2;
-        float c0;
-        float d0;
-        float xn0[2];
-        float xn1[2];
-        float xn2[2];
-        float yn1[2];
-        float yn2[2];
-        float offset[2];
     };
 
     //R1.00 FILTER FUNCTIONS
-    float Filter_Calc_BiQuad(float tSample, int channel, tp_filter* fn);
-    void Filter_BP_Coeffs(float Gain_dB, float Fc, float Q, tp_filter* fn);
-    void Filter_LP_Coeffs(float fc, tp_filter* fn);
-    void Filter_HP_Coeffs(float fc, tp_filter* fn);    
-
-    //R1.00 Our pedal filters and function def.
-    tp_filter makoF_HighPass = {};
-    tp_filter makoF_ChimeraLow = {};
-    tp_filter makoF_ChimeraHigh = {};
+    template <typename T> T Filter_Calc_BiQuad(T tSample, const tp_filter& fn, tp_history<T>& h);
+    template <typename T> T Filter_Calc_SVF(T tSample, const tp_svf& f, tp_svfstate<T>& s);
+    template <typename T> void Filter_SVF_Glide(const tp_svf& f, tp_svfstate<T>& s);
+    void Filter_SVF_Bell(float Gain_dB, float Fc, float Q, tp_svf* f, float Fs);
+    void Filter_SVF_LP(float fc, tp_svf* f, float Fs);
+    void Filter_SVF_HP(float fc, tp_svf* f, float Fs);
+    float Svf_Glide = .01f;                 //R1.02 Per sample glide at Amp_Rate. About 5mS.
+    bool SVF = false;                       //R1.02 High Cut, Low Cut and EQ use the SVFs this block.
+    //R1.02 Fs is the rate the filter runs at. The amp filters run at Amp_Rate, everything else at SampleRate.
+    void Filter_BP_Coeffs(float Gain_dB, float Fc, float Q, tp_filter* fn, float Fs);
+    void Filter_LP_Coeffs(float fc, tp_filter* fn, float Fs);
+    void Filter_HP_Coeffs(float fc, tp_filter* fn, float Fs);    
+
+    //R1.02 OVERSAMPLING - The amp runs at OS_Factor times the sample rate between two linear phase FIR
+    //R1.02 filters of OS_Taps taps per phase. Latency is OS_Taps - 1 samples for any factor.
+    static const int OS_Taps = 32;
+    static const int OS_Max = 8;
+    int OS_Factor = 1;
+    float Amp_Rate = 48000.0f;
+
+    //R1.02 CHAIN - Everything the amp and cab need to make sound: filter coefficients, IR, and the Settings they were designed for.
+    //R1.02 We keep two so a preset change can crossfade from the old chain to the new one. Their state is Arena->State[slot].
+    struct tp_chain {
+        //R1.00 Our pedal filters.
+        tp_filter makoF_HighPass;
+        tp_filter makoF_ChimeraLow;
+        tp_filter makoF_ChimeraHigh;
     
-    tp_filter makoF_HighCut = {};
-    tp_filter makoF_Band1 = {};
-    tp_filter makoF_Band2 = {};
-    tp_filter makoF_Band3 = {};
-    tp_filter makoF_Band4 = {};
-    tp_filter makoF_Band5 = {};
-        
-    //R1.00 Impulse Response Cab simulator variables.
-    float Mako_CabSim(float tSample, int channel);
-    float IRB[2][1025] = {};       //R1.00 Our stored audio buffer that gets multiplied by the IR. 
-    int IRB_Idx[2] = {};
-    float IR_VolAdjustVals[6];     //R1.00 Each IR has a different volume. Hack to balance volumes.
-    float IR_Final_VolAdjust;      //R1.00 Gets set to IR_VolAdjustVals[] when IR is selected.  
-    float IR_Final[1024] = {};     //R1.00 The IR we will use in our calculations.
-
-
-    //********************************************************************************
-    //R1.00 From here down are the 5 IMPULSE RESPONSES (speaker cabs) we are using.
-    //R1.00 Can save these in your project as WAVE files and read them. Done here
-    //R1.00 for code simplicity.
-    //R1.00 Adding more here will gradually slow the first compile time.  
-    //********************************************************************************
-     
-    //R1.00 DM03b 
-    const float IR_Stored_01[1024] = {
-0.1207, 0.450867, 0.85604, 1, 0.847137, 0.523687, 0.137589, -0.220453, -0.489089, -0.592638,
--0.515362, -0.306396, -0.069507, 0.095437, 0.169072, 0.160327, 0.096468, 0.002719, -0.076554, -0.10184,
--0.077819, -0.023656, 0.03581, 0.09129, 0.126934, 0.12774, 0.088589, 0.018597, -0.055264, -0.113416,
--0.139663, -0.133419, -0.102682, -0.063957, -0.035733, -0.02599, -0.036607, -0.057266, -0.078924, -0.090347,
--0.087349, -0.070474, -0.044994, -0.018952, 0.003127, 0.017038, 0.024204, 0.025017, 0.023435, 0.021166,
-0.019038, 0.016925, 0.012594, 0.006068, -0.004065, -0.016134, -0.029334, -0.041671, -0.051631, -0.058084,
--0.060778, -0.06033, -0.057876, -0.054605, -0.051079, -0.048093, -0.045081, -0.042291, -0.0389, -0.035396,
--0.03153, -0.027457, -0.02408, -0.021359, -0.020356, -0.020741, -0.022393, -0.024999, -0.028275, -0.031753,
--0.035112, -0.037654, -0.039245, -0.040099, -0.040043, -0.039306, -0.03766, -0.03547, -0.03277, -0.030054,
--0.027207, -0.025045, -0.023355, -0.022595, -0.023077, -0.024327, -0.026505, -0.029341, -0.032554, -0.035758,
--0.038676, -0.040842, -0.042231, -0.0432, -0.043349, -0.043483, -0.043467, -0.04365, -0.043957, -0.044136,
--0.044246, -0.043908, -0.043175, -0.042329, -0.041144, -0.039621, -0.038094, -0.036335, -0.034268, -0.032168,
--0.029919, -0.027986, -0.026067, -0.024489, -0.023534, -0.022898, -0.022416, -0.022311, -0.021917, -0.021411,
--0.020647, -0.019803, -0.018818, -0.017678, -0.016873, -0.016041, -0.015605, -0.015427, -0.015474, -0.015852,
--0.015804, -0.01611, -0.016462, -0.016504, -0.016453, -0.01595, -0.015204, -0.014583, -0.013494, -0.012335,
--0.011264, -0.010279, -0.00916, -0.00828, -0.007797, -0.007142, -0.006594, -0.006066, -0.005571, -0.004961,
--0.004222, -0.003593, -0.003059, -0.002291, -0.001679, -0.001208, -0.000768, -0.000367, 0.000154, 0.00018,
-0.000355, 0.000285, 0.000313, 0.000509, 0.000633, 0.000731, 0.000925, 0.001362, 0.001582, 0.001948,
-0.002351, 0.002717, 0.00312, 0.003624, 0.003939, 0.004437, 0.004795, 0.005244, 0.005734, 0.00623,
-0.006706, 0.007136, 0.007617, 0.007984, 0.008352, 0.0087, 0.008949, 0.009124, 0.009353, 0.009589,
-0.009712, 0.009732, 0.009813, 0.009855, 0.009865, 0.009859, 0.009722, 0.009734, 0.009804, 0.009825,
-0.009655, 0.009609, 0.009438, 0.009271, 0.009296, 0.009318, 0.009331, 0.00931, 0.009322, 0.009457,
-0.009627, 0.009607, 0.009695, 0.009733, 0.00967, 0.00968, 0.009734, 0.009634, 0.009585, 0.00958,
-0.009574, 0.009664, 0.009822, 0.009927, 0.009893, 0.009978, 0.01, 0.010071, 0.010001, 0.010201,
-0.010368, 0.010562, 0.010745, 0.010942, 0.011187, 0.011495, 0.011733, 0.012245, 0.012543, 0.012721,
-0.013297, 0.01365, 0.01396, 0.014208, 0.014619, 0.015033, 0.015512, 0.015962, 0.016474, 0.017065,
-0.017462, 0.01811, 0.018627, 0.019087, 0.019687, 0.020178, 0.020695, 0.021123, 0.021506, 0.021855,
-0.022187, 0.022575, 0.023041, 0.023455, 0.023948, 0.024272, 0.024524, 0.024861, 0.024836, 0.024418,
-0.023312, 0.021195, 0.018584, 0.01624, 0.014714, 0.014206, 0.014551, 0.015705, 0.017186, 0.018278,
-0.019161, 0.019451, 0.019015, 0.018541, 0.018014, 0.017494, 0.017442, 0.017447, 0.017306, 0.017513,
-0.017484, 0.01725, 0.016957, 0.016526, 0.016046, 0.015748, 0.01566, 0.015541, 0.015594, 0.016017,
-0.01621, 0.016506, 0.016444, 0.01647, 0.016539, 0.016516, 0.016524, 0.016635, 0.016804, 0.016928,
-0.016941, 0.017037, 0.016994, 0.016811, 0.016554, 0.016341, 0.016131, 0.015887, 0.015453, 0.015223,
-0.01499, 0.014876, 0.014704, 0.014572, 0.014251, 0.014168, 0.014251, 0.014053, 0.014028, 0.014046,
-0.013834, 0.013973, 0.013861, 0.013887, 0.013765, 0.013592, 0.013531, 0.013424, 0.013274, 0.013191,
-0.012993, 0.012668, 0.012523, 0.012297, 0.012056, 0.011928, 0.011789, 0.011782, 0.011597, 0.011519,
-0.011332, 0.011001, 0.010804, 0.010784, 0.010579, 0.01044, 0.010148, 0.010084, 0.009819, 0.009602,
-0.009346, 0.009183, 0.008896, 0.008721, 0.008509, 0.008364, 0.008279, 0.007992, 0.007958, 0.007674,
-0.007561, 0.007607, 0.007361, 0.007128, 0.00705, 0.006945, 0.006834, 0.00678, 0.006606, 0.006591,
-0.006457, 0.006431, 0.006268, 0.006234, 0.006059, 0.00604, 0.00585, 0.005686, 0.005529, 0.005531,
-0.005296, 0.005213, 0.0051, 0.005024, 0.004886, 0.004782, 0.004599, 0.004516, 0.004398, 0.004291,
-0.00412, 0.004057, 0.003864, 0.003739, 0.003701, 0.003547, 0.003389, 0.003249, 0.003007, 0.003029,
-0.002809, 0.002711, 0.002519, 0.002478, 0.00229, 0.002131, 0.002043, 0.001849, 0.001811, 0.001638,
-0.001508, 0.001274, 0.001297, 0.001147, 0.001008, 0.000833, 0.000735, 0.000627, 0.000454, 0.000389,
-0.000234, 0.000188, -0.000073, -0.00005, -0.000256, -0.000341, -0.000449, -0.000564, -0.000644, -0.000844,
--0.000879, -9.869999E-04, -0.001083, -0.001223, -0.001361, -0.00139, -0.001492, -0.001639, -0.001708, -0.001825,
--0.00192, -0.002021, -0.00212, -0.002224, -0.002293, -0.002421, -0.002462, -0.002581, -0.002659, -0.002818,
--0.002856, -0.002853, -0.003033, -0.003116, -0.003139, -0.003326, -0.003312, -0.003387, -0.003536, -0.003597,
--0.003627, -0.003758, -0.003792, -0.003901, -0.003949, -0.003951, -0.004129, -0.004149, -0.004232, -0.004252,
--0.004336, -0.004465, -0.00445, -0.004551, -0.004572, -0.004674, -0.004759, -0.004752, -0.004879, -0.004874,
--0.004925, -0.004991, -0.005059, -0.005082, -0.005223, -0.005171, -0.005289, -0.005283, -0.005371, -0.005351,
--0.005486, -0.005473, -0.005496, -0.005561, -0.005628, -0.005631, -0.005687, -0.005678, -0.005814, -0.005768,
--0.005801, -0.005868, -0.005866, -0.005923, -0.006069, -0.005943, -0.005993, -0.006062, -0.006054, -0.006105,
--0.00609, -0.006128, -0.006222, -0.006181, -0.006176, -0.006221, -0.006249, -0.006292, -0.006293, -0.006299,
--0.006356, -0.006351, -0.006304, -0.006432, -0.006351, -0.006374, -0.00645, -0.006433, -0.006384, -0.006401,
--0.006517, -0.006424, -0.00649, -0.00647, -0.006428, -0.00649, -0.006482, -0.006499, -0.006462, -0.006505,
--0.006479, -0.006523, -0.006445, -0.00651, -0.006535, -0.006468, -0.006444, -0.006479, -0.00643, -0.006511,
--0.006487, -0.00639, -0.006474, -0.006449, -0.006405, -0.006437, -0.006438, -0.006355, -0.00638, -0.006361,
--0.006389, -0.006365, -0.006369, -0.006323, -0.006325, -0.0063, -0.006191, -0.006306, -0.006235, -0.006231,
--0.006215, -0.006151, -0.00624, -0.006145, -0.006122, -0.00609, -0.006073, -0.006114, -0.006054, -0.006002,
--0.005974, -0.006024, -0.00594, -0.005948, -0.005908, -0.005899, -0.005861, -0.005787, -0.005837, -0.005719,
--0.005817, -0.005728, -0.005728, -0.005629, -0.005675, -0.005615, -0.00554, -0.005579, -0.005594, -0.005503,
--0.005498, -0.005408, -0.005439, -0.005346, -0.005354, -0.005321, -0.005248, -0.00527, -0.005141, -0.005171,
--0.005147, -0.005082, -0.005088, -0.005058, -0.005034, -0.004988, -0.004955, -0.004887, -0.004867, -0.004811,
--0.004807, -0.004774, -0.004738, -0.004628, -0.004647, -0.004645, -0.004555, -0.004546, -0.004496, -0.004474,
--0.004442, -0.004392, -0.004355, -0.004324, -0.004284, -0.004232, -0.004266, -0.004107, -0.004184, -0.004035,
--0.004076, -0.003989, -0.003998, -0.003937, -0.003881, -0.003853, -0.003822, -0.003809, -0.003653, -0.003762,
--0.003633, -0.003657, -0.00356, -0.003502, -0.003542, -0.003432, -0.00343, -0.003358, -0.003317, -0.003332,
--0.003311, -0.003157, -0.003185, -0.003107, -0.003183, -0.003036, -0.002971, -0.003047, -0.002961, -0.002833,
--0.002898, -0.002859, -0.002779, -0.002673, -0.00278, -0.002653, -0.002633, -0.002591, -0.002507, -0.00254,
--0.002489, -0.002449, -0.002416, -0.002361, -0.002315, -0.002291, -0.002244, -0.002216, -0.002149, -0.002158,
--0.002036, -0.002115, -0.001966, -0.001967, -0.001945, -0.001903, -0.001885, -0.001777, -0.001809, -0.001759,
--0.001768, -0.001671, -0.001632, -0.001651, -0.001566, -0.001523, -0.001496, -0.001494, -0.001415, -0.00143,
--0.00137, -0.001293, -0.001292, -0.001259, -0.001217, -0.00119, -0.001207, -0.001075, -0.001152, -0.001072,
--0.000979, -0.001021, -0.000929, -0.000902, -0.000849, -0.000914, -0.000825, -0.000805, -0.000808, -0.000764,
--0.000705, -0.00067, -0.000635, -0.000615, -0.000514, -0.000561, -0.000518, -0.000502, -0.000433, -0.000448,
--0.00045, -0.000334, -0.000346, -0.000342, -0.000297, -0.000144, -0.000316, -0.000227, -0.000181, -0.000158,
--0.000142, -0.00005, -0.000088, -0.000038, 0.00002, 0.000011, 0.000021, 0.000051, 0.000056, 0.000118,
-0.000135, 0.000138, 0.000184, 0.000183, 0.000211, 0.000249, 0.000292, 0.000299, 0.000301, 0.000341,
-0.000398, 0.000372, 0.00035, 0.00045, 0.000486, 0.000437, 0.000506, 0.00051, 0.000552, 0.000529,
-0.0006, 0.000527, 0.000588, 0.000664, 0.000612, 0.000681, 0.000668, 0.00074, 0.000785, 0.000701,
-0.000775, 0.000748, 0.000776, 0.000777, 0.000809, 0.000831, 0.000884, 0.000841, 0.000864, 0.000884,
-0.000953, 0.000961, 0.000886, 0.00099, 0.000937, 0.000976, 0.001044, 0.00099, 0.00102, 0.001056,
-0.001016, 0.001074, 0.001075, 0.001104, 0.001048, 0.001102, 0.001174, 0.00113, 0.001138, 0.001183,
-0.001105, 0.001133, 0.001218, 0.001219, 0.00122, 0.001168, 0.001247, 0.001219, 0.001287, 0.001254,
-0.001215, 0.001267, 0.001259, 0.001267, 0.001329, 0.001231, 0.001266, 0.001304, 0.001325, 0.001287,
-0.00135, 0.001381, 0.001354, 0.001316, 0.001343, 0.001324, 0.001346, 0.001361, 0.001374, 0.001333,
-0.001392, 0.001388, 0.001383, 0.001423, 0.001363, 0.00137, 0.001377, 0.001396, 0.001394, 0.001402,
-0.001401, 0.001419, 0.001396, 0.001441, 0.001413, 0.001359, 0.001423, 0.001459, 0.001361, 0.001406,
-0.001422, 0.001436, 0.001473, 0.001378, 0.00146, 0.001396, 0.001336, 0.001463, 0.001455, 0.001353,
-0.0014, 0.001436, 0.001411, 0.001419, 0.001392, 0.001438, 0.001412, 0.001379, 0.001435, 0.001372,
-0.001423, 0.001319, 0.001441, 0.001384, 0.001349, 0.001397, 0.001457, 0.001318, 0.001324, 0.001361,
-0.001403, 0.00135, 0.001351, 0.001365, 0.001377, 0.001296, 0.001334, 0.001332, 0.001335, 0.001328,
-0.001332, 0.001292, 0.001381, 0.001271, 0.001303, 0.001233, 0.00131, 0.001289, 0.001302, 0.001269,
-0.001295, 0.001204, 0.001293, 0.001211, 0.001243, 0.001243, 0.001196, 0.001282, 0.001214, 0.001166,
-0.001173, 0.00124, 0.001127, 0.001253, 0.001173, 0.001226, 0.001127, 0.001134, 0.001206, 0.001083,
-0.001171, 0.001116, 0.00109, 0.001055, 0.001161, 0.001082, 0.00112, 0.001096, 0.001114, 0.001044,
-0.001053, 0.001068, 0.001001, 0.001027, 0.001067, 0.001016, 0.001, 0.001041, 0.000973, 0.000965,
-0.000967, 0.000939, 0.000978, 0.000928, 0.000975, 0.000949, 0.00094, 0.000936, 0.000919, 0.000874,
-0.000908, 0.000835, 0.000867, 0.000895, 0.000824, 0.000832, 0.000839, 0.000873, 0.0008, 0.000827,
-0.000826, 0.000784, 0.000803, 0.000784, 0.000748, 0.000804, 0.000744, 0.000699, 0.00076, 0.000699,
-0.000686, 0.0008, 0.00072, 0.000723, 0.000657, 0.000693, 0.000625, 0.000651, 0.000625, 0.000643,
-0.000655, 0.000585, 0.000643, 0.000563,
+        tp_filter makoF_HighCut;
+        tp_filter makoF_Band1;
+        tp_filter makoF_Band2;
+        tp_filter makoF_Band3;
+        tp_filter makoF_Band4;
+        tp_filter makoF_Band5;
+
+        //R1.02 The same filters as SVF targets.
+        tp_svf makoS_HighPass;
+        tp_svf makoS_HighCut;
+        tp_svf makoS_Band[5];
+
+        //R1.00 Impulse Response Cab simulator variables.
+        float IR_Final_VolAdjust;           //R1.00 Gets set to IR_Stored_Vol[] when IR is selected.  
+        const float* IR_Final;              //R1.02 Points at the stored IR or blend kernel we will use in our calculations.
+        const float* IR_Old;                //R1.02 The IR we are fading out of. Null when not fading.
+        float IR_OldVol;
+        int IR_FadePos;
+
+        int Eco_Model;                      //R1.02 Eco cab biquads are Eco_Coeffs[Eco_Model].
+
+        float Set[Setting_Max];             //R1.02 Copy of Setting[] this chain was designed for.
+        float Design_Rate;                  //R1.02 Amp_Rate the filters were designed at.
     };
 
-
-    //R1.00 Made_9_01C
-    const float IR_Stored_02[1024] = {
-0.004242, 0.10733, 0.498566, 0.704895, 0.76886, 0.881683, 0.533234, 0.332703, 0.073578, -0.302887,
--0.276733, -0.459656, -0.327576, -0.204163, -0.128265, 0.111908, 0.083832, 0.216553, 0.124817, 0.093842,
-0.024231, -0.091278, -0.091095, -0.191772, -0.132172, -0.175751, -0.109009, -0.108551, -0.089447, -0.069611,
--0.109436, -0.079315, -0.13974, -0.101044, -0.138275, -0.100891, -0.098114, -0.079346, -0.051025, -0.061981,
--0.029419, -0.063538, -0.038513, -0.074738, -0.058563, -0.075775, -0.067352, -0.05899, -0.061157, -0.035828,
--0.051208, -0.023315, -0.046234, -0.026489, -0.047516, -0.039337, -0.048798, -0.052765, -0.046448, -0.060455,
--0.043457, -0.063721, -0.044678, -0.065033, -0.051697, -0.066101, -0.062042, -0.064484, -0.070709, -0.061188,
--0.073944, -0.056732, -0.072205, -0.054413, -0.068207, -0.055969, -0.06308, -0.059418, -0.057648, -0.061951,
--0.051361, -0.060516, -0.044434, -0.055847, -0.039581, -0.048859, -0.038025, -0.042084, -0.039154, -0.036774,
--0.040283, -0.031647, -0.040436, -0.02829, -0.038208, -0.027374, -0.034821, -0.028076, -0.031891, -0.030365,
--0.028595, -0.032684, -0.026459, -0.034149, -0.02536, -0.033966, -0.026703, -0.033081, -0.029388, -0.031921,
--0.032379, -0.030792, -0.0354, -0.029938, -0.036438, -0.02951, -0.035797, -0.029449, -0.033051, -0.029663,
--0.030151, -0.029999, -0.026154, -0.029297, -0.022583, -0.027557, -0.019684, -0.024567, -0.018158, -0.020569,
--0.01712, -0.01593, -0.015747, -0.011414, -0.013702, -0.006226, -0.009613, -0.001221, -0.004486, 0.002777,
-0.001221, 0.00528, 0.007172, 0.007507, 0.011841, 0.009491, 0.015808, 0.011993, 0.019135, 0.015198,
-0.020721, 0.018433, 0.021515, 0.021362, 0.020782, 0.023499, 0.020264, 0.024414, 0.019501, 0.024475,
-0.019043, 0.023743, 0.019806, 0.021576, 0.020569, 0.020355, 0.021484, 0.018372, 0.022064, 0.017822,
-0.022003, 0.017365, 0.021637, 0.018372, 0.020966, 0.02005, 0.020264, 0.022003, 0.020538, 0.024078,
-0.020996, 0.025665, 0.022217, 0.026581, 0.024109, 0.027039, 0.026001, 0.027435, 0.028534, 0.028076,
-0.031067, 0.028625, 0.032776, 0.029968, 0.034363, 0.032104, 0.034943, 0.033661, 0.035217, 0.035614,
-0.035339, 0.037323, 0.035645, 0.038513, 0.036011, 0.039001, 0.036865, 0.039001, 0.037567, 0.038086,
-0.037292, 0.037292, 0.038147, 0.036407, 0.038086, 0.03598, 0.03772, 0.035797, 0.036896, 0.035736,
-0.036072, 0.035583, 0.034821, 0.035431, 0.033966, 0.03537, 0.033661, 0.034698, 0.033295, 0.034271,
-0.033508, 0.034027, 0.03418, 0.033783, 0.034851, 0.034088, 0.035431, 0.03418, 0.035797, 0.034485,
-0.035767, 0.035309, 0.036041, 0.036438, 0.036285, 0.037415, 0.036774, 0.038177, 0.036835, 0.038544,
-0.037445, 0.038269, 0.037567, 0.037994, 0.037537, 0.036896, 0.03714, 0.03595, 0.036469, 0.03479,
-0.036072, 0.034332, 0.034943, 0.033203, 0.033112, 0.032288, 0.030853, 0.030548, 0.028839, 0.028778,
-0.027008, 0.027405, 0.025391, 0.025818, 0.024628, 0.024323, 0.023438, 0.02243, 0.022491, 0.02066,
-0.020599, 0.019012, 0.019531, 0.018372, 0.019043, 0.018158, 0.018555, 0.01828, 0.018036, 0.017792,
-0.017242, 0.016968, 0.015747, 0.0159, 0.014618, 0.015106, 0.013947, 0.014496, 0.013397, 0.013672,
-0.013275, 0.012756, 0.012787, 0.011841, 0.012024, 0.010559, 0.011078, 0.009918, 0.010223, 0.009125,
-0.009033, 0.008698, 0.007996, 0.007507, 0.006744, 0.0065, 0.005432, 0.006165, 0.004395, 0.004761,
-0.003601, 0.003601, 0.003204, 0.002686, 0.00238, 0.001587, 0.001556, 0.00061, 0.000763, -0.000092,
--0.000275, -0.00116, -0.000854, -0.001801, -0.002319, -0.002838, -0.003113, -0.003113, -0.003815, -0.003448,
--0.003845, -0.004089, -0.004883, -0.004944, -0.005249, -0.005554, -0.006287, -0.0065, -0.006805, -0.006622,
--0.007141, -0.007813, -0.007263, -0.008331, -0.007935, -0.008575, -0.009033, -0.009338, -0.009552, -0.009979,
--0.010193, -0.010559, -0.010956, -0.0112, -0.011475, -0.011627, -0.012329, -0.012451, -0.012512, -0.012726,
--0.01297, -0.013153, -0.013184, -0.013794, -0.01416, -0.014343, -0.014771, -0.015015, -0.014954, -0.014984,
--0.015045, -0.015259, -0.014923, -0.015442, -0.015503, -0.015564, -0.01593, -0.016052, -0.016327, -0.016144,
--0.016541, -0.016113, -0.016357, -0.016144, -0.016418, -0.016235, -0.016449, -0.016968, -0.016907, -0.01709,
--0.016968, -0.017487, -0.016937, -0.017334, -0.017059, -0.017212, -0.017242, -0.01709, -0.01709, -0.017365,
--0.017548, -0.017792, -0.017822, -0.017853, -0.017975, -0.017914, -0.018188, -0.017853, -0.018372, -0.017944,
--0.018127, -0.018097, -0.01825, -0.018188, -0.018341, -0.018433, -0.018097, -0.018463, -0.01828, -0.018402,
--0.018127, -0.018402, -0.017761, -0.018372, -0.018341, -0.018127, -0.018463, -0.018097, -0.018616, -0.018555,
--0.018829, -0.01825, -0.018555, -0.018158, -0.018219, -0.017975, -0.017853, -0.017944, -0.017731, -0.017944,
--0.017334, -0.018036, -0.017578, -0.017914, -0.017578, -0.0177, -0.017822, -0.017487, -0.017517, -0.01709,
--0.017273, -0.016754, -0.016846, -0.016327, -0.016876, -0.016296, -0.016724, -0.016541, -0.016296, -0.016632,
--0.016083, -0.016449, -0.015503, -0.015869, -0.015717, -0.015869, -0.015472, -0.015594, -0.015259, -0.015137,
--0.015045, -0.014679, -0.014709, -0.014038, -0.01474, -0.013916, -0.014709, -0.014008, -0.014587, -0.014221,
--0.01416, -0.014343, -0.013733, -0.013947, -0.013519, -0.013916, -0.013092, -0.013458, -0.012878, -0.013123,
--0.012512, -0.012848, -0.012421, -0.01239, -0.012268, -0.012024, -0.012054, -0.011414, -0.012299, -0.011292,
--0.011841, -0.011139, -0.011444, -0.0112, -0.0112, -0.010834, -0.010468, -0.010681, -0.009735, -0.010345,
--0.009735, -0.010254, -0.009369, -0.009918, -0.009277, -0.00943, -0.009308, -0.008575, -0.009277, -0.008331,
--0.008881, -0.008087, -0.008636, -0.007996, -0.008392, -0.007813, -0.00766, -0.007843, -0.006989, -0.007507,
--0.006622, -0.007477, -0.006439, -0.00705, -0.006317, -0.006592, -0.006195, -0.006073, -0.006317, -0.005463,
--0.006165, -0.005005, -0.005737, -0.004822, -0.005371, -0.004608, -0.004761, -0.004456, -0.004425, -0.004333,
--0.004272, -0.004669, -0.003815, -0.004639, -0.00354, -0.004242, -0.003113, -0.003601, -0.00293, -0.002869,
--0.002899, -0.002258, -0.002777, -0.001862, -0.002686, -0.001892, -0.002502, -0.001648, -0.002136, -0.001587,
--0.001923, -0.001465, -0.001404, -0.001801, -0.000793, -0.001434, -0.000305, -0.001038, -0.000153, -0.00058,
--0.000275, -0.000519, -0.000366, -0.000061, -0.000671, 0.000244, -0.00061, 0.000549, -0.000092, 0.001129,
-0.000763, 0.001343, 0.00119, 0.001068, 0.001526, 0.000793, 0.001587, 0.000671, 0.001709, 0.000977,
-0.002075, 0.001617, 0.00238, 0.002411, 0.002411, 0.002899, 0.001984, 0.002808, 0.001984, 0.002899,
-0.001862, 0.003174, 0.002472, 0.003052, 0.002991, 0.003082, 0.003448, 0.003143, 0.003937, 0.00296,
-0.004211, 0.003448, 0.004181, 0.003448, 0.004089, 0.003479, 0.003693, 0.003876, 0.003693, 0.004578,
-0.003754, 0.005066, 0.00415, 0.005188, 0.004456, 0.005402, 0.005035, 0.004944, 0.005249, 0.004364,
-0.005249, 0.004364, 0.005737, 0.004578, 0.005707, 0.005066, 0.005707, 0.005341, 0.005585, 0.005707,
-0.004944, 0.005707, 0.004974, 0.006195, 0.00528, 0.00647, 0.005615, 0.006226, 0.005676, 0.005829,
-0.006012, 0.005524, 0.006348, 0.005768, 0.006531, 0.006012, 0.007019, 0.006165, 0.006409, 0.006378,
-0.006165, 0.006592, 0.005859, 0.006866, 0.005798, 0.006958, 0.00589, 0.006775, 0.006439, 0.006836,
-0.006866, 0.006989, 0.007629, 0.006989, 0.007874, 0.006866, 0.007965, 0.006958, 0.007721, 0.006989,
-0.007355, 0.007324, 0.007172, 0.00766, 0.007202, 0.008026, 0.007263, 0.008118, 0.007111, 0.007965,
-0.007172, 0.007751, 0.007538, 0.007385, 0.007751, 0.007477, 0.00827, 0.007385, 0.008301, 0.007324,
-0.007965, 0.006958, 0.007507, 0.007263, 0.007324, 0.008057, 0.007416, 0.008301, 0.007446, 0.008484,
-0.007355, 0.008087, 0.007385, 0.007538, 0.007385, 0.007141, 0.00769, 0.007446, 0.008209, 0.007324,
-0.00827, 0.007446, 0.008392, 0.007782, 0.007843, 0.007782, 0.007355, 0.007904, 0.007324, 0.007996,
-0.007263, 0.00824, 0.00766, 0.008087, 0.00766, 0.007568, 0.00769, 0.007355, 0.007721, 0.006989,
-0.007782, 0.006989, 0.007843, 0.006958, 0.007507, 0.007263, 0.006958, 0.007324, 0.006622, 0.007385,
-0.006714, 0.007599, 0.007019, 0.007904, 0.006958, 0.007416, 0.007141, 0.007416, 0.007477, 0.006958,
-0.007294, 0.006531, 0.007446, 0.006317, 0.006989, 0.006409, 0.006836, 0.00647, 0.006744, 0.006866,
-0.006683, 0.007172, 0.006409, 0.00708, 0.006104, 0.006897, 0.006012, 0.006531, 0.006409, 0.006317,
-0.006714, 0.0065, 0.006989, 0.006042, 0.006958, 0.006042, 0.00647, 0.005859, 0.006226, 0.006226,
-0.005707, 0.00647, 0.006073, 0.006836, 0.006042, 0.006592, 0.005951, 0.006348, 0.005859, 0.005768,
-0.006195, 0.005737, 0.006042, 0.005463, 0.006439, 0.005615, 0.006195, 0.005646, 0.005737, 0.005798,
-0.00531, 0.005646, 0.005249, 0.005737, 0.00528, 0.005646, 0.005127, 0.005493, 0.004974, 0.00531,
-0.005096, 0.004913, 0.004974, 0.004791, 0.005219, 0.004578, 0.005127, 0.004242, 0.004883, 0.004486,
-0.004486, 0.004364, 0.004547, 0.004608, 0.004303, 0.004547, 0.004303, 0.004913, 0.003998, 0.004669,
-0.003998, 0.004089, 0.004059, 0.004028, 0.004181, 0.003906, 0.004364, 0.003662, 0.004395, 0.003815,
-0.003967, 0.00354, 0.003601, 0.00351, 0.003143, 0.003754, 0.003235, 0.003784, 0.003326, 0.00351,
-0.003235, 0.00351, 0.003265, 0.003143, 0.003479, 0.002991, 0.00354, 0.003052, 0.003387, 0.00296,
-0.002991, 0.002625, 0.00238, 0.00238, 0.002533, 0.002625, 0.002197, 0.002686, 0.002197, 0.002625,
-0.002411, 0.002472, 0.002136, 0.002045, 0.00235, 0.002075, 0.002258, 0.00177, 0.002472, 0.001648,
-0.001953, 0.001709, 0.001831, 0.001892, 0.001617, 0.001862, 0.001556, 0.001892, 0.00119, 0.001953,
-0.001373, 0.001587, 0.001221, 0.001129, 0.001221, 0.001038, 0.001099, 0.000916, 0.001404, 0.000885,
-0.00119, 0.001099, 0.001068, 0.001282, 0.000763, 0.000946, 0.000336, 0.000458, 0.000153, 0.000366,
-0.000275, 0.000366, 0.000366, 0.000488, 0.00058, 0.000549, 0.00061, 0.000458, 0.000366, 0.000153,
-0.000244, 0.000061, 0.000275, 0.000061, 0.000153, 0, -0.000122, 0.000092, -0.000183, -0.000183,
--0.000488, -0.000183, -0.000244, -0.000244, -0.000397, -0.000244, -0.000366, -0.000488, -0.00061, -0.000824,
--0.000488, -0.000702, -0.000397, -0.000732, -0.000336, -0.000488, -0.000549, -0.000488, -0.001068, -0.000671,
--0.001038, -0.000824, -0.001068, -0.001068, -0.000824, -0.000916, -0.000671, -0.000916, -0.000885, -0.001068,
--0.00119, -0.001099, -0.00116, -0.001129, -0.001312, -0.001343, -0.001343, -0.000977, -0.001251, -0.000977,
--0.001282, -0.001221, -0.001282, -0.001373, -0.001221, -0.001373, -0.001038, -0.001465, -0.001251, -0.001129,
--0.001282, -0.001251, -0.001495, -0.001404, -0.001526, -0.001434, -0.00119, -0.001221, -0.001251, -0.001251,
--0.001251, -0.001251, -0.001251, -0.001282,
+    //R1.02 ARENA - All of the audio thread state and coefficients in one 64 byte aligned block, in the order a
+    //R1.02 sample goes thru it. It is a separate allocation, so nothing the editor writes shares a cache line with it.
+    //R1.02 Each channel starts on its own cache line so two cores can run the channels. tp_arena is after the profiles.
+    struct alignas(64) tp_dyn {
+        float Gate_Env;                     //R1.00 Was Signal_AVG. Input envelope.
+        float Gate_Gain;                    //R1.00 Was Pedal_NGate_Fac.
+        int Gate_Open;
+        int Gate_Hold;
+        int Gate_Silent;                    //R1.02 Samples of silence the gate has sent to the amp.
+        float Comp_Level;                   //R1.00 Was Pedal_CompGain. Detector level.
+        float Ctrl_Gain[e_CtrlPoints];      //R1.02 Gain each control point ended on. Was Comp_Gain for e_CtrlPost.
     };
 
+    //R1.02 Amp and cab state in the sample type. Float and double hosts each have their own set.
+    template <typename T>
+    struct alignas(64) tp_state {
+        tp_history<T> Band[5];
+        double ADAA_X[4];                   //R1.02 Last input and antiderivative of each ADAA shaper, by a_Drive etc.
+        double ADAA_F[4];
+        T Sag_Last;                         //R1.01 Sag sample storage.
+        tp_history<T> HighCut;
+        tp_history<T> ChimeraLow;
+        tp_history<T> ChimeraHigh;
+        tp_history<T> HighPass;
+        tp_svfstate<T> SVF_Band[5];         //R1.02 SVF versions of Band, HighCut and HighPass.
+        tp_svfstate<T> SVF_HighCut;
+        tp_svfstate<T> SVF_HighPass;
+        int IRB_Idx;
+        juce::int64 Pos;                    //R1.02 Samples thru the cab. Tags our pool results.
+        tp_history<T> Eco[12];
+        int OS_InIdx;                       //R1.02 Oversampler rings, newest first and written twice so reads never wrap.
+        int OS_OutIdx;
+        alignas(64) T IRB[1025];            //R1.00 Our stored audio buffer that gets multiplied by the IR. 
+        alignas(64) T OS_In[OS_Taps * 2];
+        T OS_Out[OS_Taps * OS_Max * 2];
+    };
 
-    //R1.00 Made09e
-    const float IR_Stored_03[1024] = {
-0, 0.529327, 0.787048, 0.881073, 0.999969, 0.596344, 0.301758, -0.011047, -0.440887, -0.419739,
--0.578735, -0.43219, -0.272186, -0.187775, 0.061981, 0.035614, 0.158966, 0.069336, 0.032898, -0.028931,
--0.139069, -0.132324, -0.228699, -0.171265, -0.219513, -0.162323, -0.170624, -0.160889, -0.144531, -0.185913,
--0.149658, -0.202118, -0.151611, -0.17746, -0.131134, -0.120667, -0.09964, -0.068817, -0.081665, -0.048248,
--0.083252, -0.055908, -0.089722, -0.070465, -0.083588, -0.073517, -0.061829, -0.064789, -0.037811, -0.054718,
--0.025848, -0.04834, -0.027161, -0.045502, -0.036041, -0.042267, -0.046387, -0.038208, -0.053802, -0.036865,
--0.05899, -0.041077, -0.062012, -0.049683, -0.063049, -0.059601, -0.059906, -0.066437, -0.055145, -0.067902,
--0.049713, -0.064728, -0.046631, -0.059296, -0.047089, -0.052246, -0.048492, -0.044586, -0.048553, -0.036163,
--0.044586, -0.027313, -0.037689, -0.020905, -0.028656, -0.017609, -0.019867, -0.016693, -0.012695, -0.015778,
--0.005829, -0.01413, -0.001556, -0.010834, -0.000214, -0.006927, -0.00058, -0.003693, -0.002533, 0,
--0.004272, 0.002258, -0.005432, 0.003204, -0.005188, 0.001434, -0.004669, -0.001709, -0.004028, -0.005066,
--0.003357, -0.008362, -0.002991, -0.009552, -0.002899, -0.008972, -0.002991, -0.006104, -0.003021, -0.003052,
--0.002991, 0.001373, -0.001526, 0.005554, 0.001007, 0.008972, 0.004639, 0.010986, 0.009155, 0.012573,
-0.014282, 0.014587, 0.019318, 0.017242, 0.025085, 0.022217, 0.030823, 0.028076, 0.035339, 0.034302,
-0.038269, 0.040619, 0.040863, 0.045288, 0.042786, 0.04892, 0.044922, 0.051605, 0.047455, 0.052216,
-0.049591, 0.051849, 0.051239, 0.049713, 0.051788, 0.047791, 0.051025, 0.045258, 0.049164, 0.042908,
-0.046448, 0.041748, 0.042267, 0.040466, 0.039246, 0.039551, 0.035461, 0.038269, 0.033325, 0.036652,
-0.031342, 0.03476, 0.030975, 0.032806, 0.031403, 0.030945, 0.032227, 0.030304, 0.033417, 0.029968,
-0.034149, 0.030426, 0.034302, 0.031647, 0.034119, 0.032837, 0.033844, 0.034698, 0.033875, 0.03656,
-0.033752, 0.037506, 0.034393, 0.038452, 0.03595, 0.0383, 0.036621, 0.037659, 0.037689, 0.036987,
-0.038483, 0.036285, 0.038605, 0.035522, 0.037872, 0.035217, 0.036743, 0.034668, 0.034454, 0.032928,
-0.032257, 0.032532, 0.030151, 0.031128, 0.028351, 0.029327, 0.026794, 0.027222, 0.025482, 0.025238,
-0.024139, 0.022797, 0.022858, 0.020874, 0.021759, 0.019592, 0.020111, 0.018219, 0.018799, 0.01767,
-0.017883, 0.017731, 0.017029, 0.017853, 0.016907, 0.018005, 0.016479, 0.017883, 0.016388, 0.017456,
-0.016815, 0.017395, 0.017639, 0.017334, 0.018219, 0.017395, 0.018585, 0.017029, 0.018494, 0.017273,
-0.017792, 0.016846, 0.016998, 0.016174, 0.015198, 0.015015, 0.013489, 0.013611, 0.011566, 0.012512,
-0.010468, 0.01062, 0.008453, 0.007904, 0.006775, 0.004944, 0.004211, 0.002136, 0.001709, -0.000366,
--0.000275, -0.002625, -0.002472, -0.003845, -0.004333, -0.005402, -0.006592, -0.006592, -0.008453, -0.008667,
--0.010284, -0.009705, -0.010773, -0.009979, -0.010742, -0.010254, -0.010376, -0.010437, -0.010529, -0.010834,
--0.010925, -0.011993, -0.011658, -0.012756, -0.012054, -0.013031, -0.012299, -0.013275, -0.012848, -0.013,
--0.013336, -0.013062, -0.013763, -0.013336, -0.014618, -0.013885, -0.014832, -0.014282, -0.015259, -0.015259,
--0.015411, -0.015961, -0.016357, -0.016968, -0.016998, -0.017944, -0.016907, -0.018463, -0.018005, -0.018982,
--0.018799, -0.018921, -0.019196, -0.019287, -0.019836, -0.019623, -0.020325, -0.019836, -0.020416, -0.020294,
--0.020966, -0.020294, -0.020935, -0.02124, -0.021515, -0.021454, -0.021027, -0.021393, -0.020599, -0.020599,
--0.020508, -0.021057, -0.020721, -0.020599, -0.020508, -0.020935, -0.020844, -0.020782, -0.020172, -0.020294,
--0.020782, -0.019836, -0.020569, -0.019867, -0.020081, -0.020264, -0.020294, -0.020111, -0.020233, -0.020142,
--0.020203, -0.020325, -0.020294, -0.020264, -0.020111, -0.020569, -0.020416, -0.020142, -0.019958, -0.019897,
--0.019806, -0.019501, -0.019836, -0.019989, -0.019867, -0.019928, -0.019897, -0.01947, -0.019135, -0.01886,
--0.018799, -0.018127, -0.018341, -0.018097, -0.017792, -0.017822, -0.017639, -0.017578, -0.017059, -0.01712,
--0.016388, -0.016296, -0.015808, -0.015808, -0.01532, -0.015198, -0.015503, -0.015198, -0.015076, -0.014618,
--0.014923, -0.01413, -0.014252, -0.013794, -0.013672, -0.013489, -0.013092, -0.012817, -0.012909, -0.012939,
--0.01297, -0.012817, -0.012634, -0.012573, -0.01236, -0.012512, -0.012054, -0.012421, -0.01181, -0.01181,
--0.011627, -0.011627, -0.011383, -0.011383, -0.011353, -0.010834, -0.011047, -0.010773, -0.010773, -0.010315,
--0.010437, -0.009644, -0.010132, -0.01004, -0.009674, -0.009857, -0.009369, -0.009735, -0.009644, -0.009857,
--0.009094, -0.009247, -0.008728, -0.008667, -0.008301, -0.008057, -0.008057, -0.007721, -0.007843, -0.00708,
--0.007629, -0.007172, -0.007416, -0.007019, -0.00705, -0.007172, -0.006775, -0.006714, -0.006165, -0.006317,
--0.005707, -0.005707, -0.005096, -0.005646, -0.005035, -0.005371, -0.005188, -0.004852, -0.005188, -0.004639,
--0.004974, -0.003998, -0.004272, -0.004211, -0.004395, -0.003998, -0.004028, -0.003662, -0.003479, -0.003265,
--0.00296, -0.00296, -0.002197, -0.00296, -0.002136, -0.002991, -0.00238, -0.00296, -0.002716, -0.002655,
--0.002899, -0.002289, -0.002472, -0.002075, -0.002533, -0.001709, -0.002014, -0.001434, -0.001678, -0.001068,
--0.001434, -0.001038, -0.001038, -0.000885, -0.000702, -0.000793, -0.000153, -0.001099, -0.000183, -0.000732,
--0.000092, -0.000397, -0.000244, -0.000305, 0.000031, 0.000458, 0.000153, 0.001129, 0.000427, 0.000946,
-0.000366, 0.001221, 0.000702, 0.001251, 0.001068, 0.001068, 0.001831, 0.001007, 0.001892, 0.001282,
-0.002014, 0.001434, 0.001953, 0.001495, 0.002045, 0.002228, 0.001923, 0.002747, 0.002167, 0.002991,
-0.002045, 0.003021, 0.00238, 0.002991, 0.002747, 0.003052, 0.003143, 0.002716, 0.003571, 0.002777,
-0.003906, 0.003143, 0.003967, 0.003357, 0.004059, 0.003876, 0.00412, 0.004059, 0.004089, 0.004059,
-0.00351, 0.004333, 0.003448, 0.004456, 0.003693, 0.004761, 0.004242, 0.004791, 0.004852, 0.00473,
-0.005341, 0.004761, 0.005646, 0.00473, 0.005402, 0.0047, 0.005493, 0.004944, 0.005402, 0.004974,
-0.00531, 0.005341, 0.004791, 0.005768, 0.005096, 0.006195, 0.005402, 0.006195, 0.005737, 0.00592,
-0.005615, 0.005676, 0.005951, 0.005188, 0.006042, 0.005127, 0.006195, 0.005524, 0.006714, 0.006348,
-0.006866, 0.006592, 0.006409, 0.006836, 0.006012, 0.006775, 0.005798, 0.006744, 0.005951, 0.006958,
-0.00647, 0.007111, 0.007141, 0.007019, 0.007507, 0.00647, 0.007202, 0.006409, 0.007294, 0.006165,
-0.007416, 0.006653, 0.00708, 0.006989, 0.006958, 0.007294, 0.006927, 0.007721, 0.006683, 0.007874,
-0.007141, 0.007782, 0.006958, 0.007477, 0.006805, 0.006866, 0.00705, 0.006775, 0.00769, 0.006775,
-0.008057, 0.007111, 0.008087, 0.007324, 0.008209, 0.007904, 0.00769, 0.007935, 0.006927, 0.007721,
-0.006805, 0.008179, 0.006958, 0.007965, 0.007263, 0.007813, 0.007416, 0.007599, 0.007751, 0.006836,
-0.007538, 0.006805, 0.008057, 0.00708, 0.008209, 0.007294, 0.007813, 0.007172, 0.007202, 0.007416,
-0.006866, 0.007721, 0.007111, 0.007813, 0.007263, 0.008209, 0.007324, 0.007416, 0.007324, 0.007111,
-0.007538, 0.006744, 0.00769, 0.006592, 0.00766, 0.006561, 0.007294, 0.006989, 0.007355, 0.007416,
-0.007507, 0.008179, 0.007538, 0.008362, 0.007294, 0.008331, 0.007355, 0.007996, 0.007233, 0.007477,
-0.007416, 0.007202, 0.00766, 0.007141, 0.007935, 0.007111, 0.007874, 0.006836, 0.007629, 0.006836,
-0.007385, 0.007172, 0.006927, 0.007233, 0.006927, 0.00769, 0.006744, 0.007568, 0.006531, 0.00705,
-0.006012, 0.00647, 0.006226, 0.006256, 0.007019, 0.006348, 0.007111, 0.006226, 0.007233, 0.006042,
-0.006714, 0.006012, 0.006134, 0.005951, 0.005585, 0.006165, 0.00589, 0.006622, 0.005646, 0.006531,
-0.005676, 0.006622, 0.006073, 0.006073, 0.005981, 0.005463, 0.005981, 0.005371, 0.006012, 0.005219,
-0.006104, 0.005524, 0.00589, 0.005432, 0.005249, 0.005371, 0.005005, 0.005371, 0.004578, 0.00528,
-0.004486, 0.00528, 0.004364, 0.004791, 0.004547, 0.00415, 0.004517, 0.003815, 0.004547, 0.003906,
-0.00473, 0.004181, 0.005035, 0.004059, 0.004364, 0.00412, 0.004456, 0.004517, 0.003937, 0.004211,
-0.003326, 0.004242, 0.003113, 0.003662, 0.003082, 0.003448, 0.003052, 0.003326, 0.003448, 0.003265,
-0.003754, 0.00296, 0.003571, 0.002594, 0.003357, 0.002472, 0.00293, 0.002869, 0.002686, 0.003052,
-0.002838, 0.003326, 0.002319, 0.003143, 0.002289, 0.002686, 0.002045, 0.00235, 0.002441, 0.001801,
-0.002533, 0.002228, 0.00293, 0.002106, 0.002594, 0.001953, 0.002319, 0.001831, 0.001678, 0.002167,
-0.001709, 0.001923, 0.001282, 0.002258, 0.001465, 0.001953, 0.001404, 0.001404, 0.001526, 0.000977,
-0.001312, 0.000946, 0.001373, 0.000916, 0.001221, 0.000671, 0.000977, 0.000458, 0.000763, 0.00058,
-0.000336, 0.000397, 0.000183, 0.00061, -0.000031, 0.000488, -0.000427, 0.000122, -0.000214, -0.000244,
--0.000366, -0.000183, -0.000061, -0.000427, -0.000214, -0.000458, 0.000214, -0.000702, -0.000122, -0.000763,
--0.000732, -0.000702, -0.000763, -0.00061, -0.000885, -0.000427, -0.00116, -0.000458, -0.000977, -0.000885,
--0.001343, -0.001312, -0.001373, -0.00177, -0.001129, -0.001617, -0.001099, -0.001556, -0.001434, -0.001709,
--0.001434, -0.001617, -0.00177, -0.001343, -0.001831, -0.001312, -0.00177, -0.001465, -0.001892, -0.001953,
--0.002319, -0.002655, -0.002655, -0.002411, -0.002258, -0.002747, -0.002289, -0.002777, -0.00235, -0.002502,
--0.002441, -0.002777, -0.002899, -0.002502, -0.002747, -0.002563, -0.003082, -0.002411, -0.003204, -0.002991,
--0.003143, -0.003052, -0.00293, -0.003204, -0.00296, -0.003265, -0.002869, -0.003601, -0.002838, -0.003326,
--0.003143, -0.00351, -0.003662, -0.00354, -0.003662, -0.003632, -0.003815, -0.003296, -0.003784, -0.00351,
--0.00354, -0.00354, -0.003296, -0.003815, -0.003662, -0.004272, -0.004181, -0.004456, -0.004242, -0.004272,
--0.004211, -0.004211, -0.004028, -0.003906, -0.003906, -0.003815, -0.003937, -0.003998, -0.004181, -0.004089,
--0.004211, -0.003967, -0.00415, -0.00412, -0.004272, -0.004425, -0.00415, -0.004395, -0.004364, -0.004517,
--0.004303, -0.004242, -0.004211, -0.004333, -0.004181, -0.004303, -0.004456, -0.004608, -0.004883, -0.004517,
--0.004669, -0.004303, -0.004639, -0.004211, -0.004272, -0.004333, -0.004242, -0.004852, -0.004456, -0.004761,
--0.004547, -0.00473, -0.004791, -0.004486, -0.004547, -0.004272, -0.004486, -0.004486, -0.004608, -0.004761,
--0.004578, -0.004608, -0.004517, -0.00473, -0.004761, -0.004761, -0.004303, -0.004517, -0.004242, -0.004517,
--0.004456, -0.004456, -0.004547, -0.004303, -0.004425, -0.004059, -0.004486, -0.004303, -0.00412, -0.004272,
--0.004211, -0.004456, -0.004333, -0.004425, -0.004272, -0.003967, -0.003937, -0.003998, -0.004028, -0.003998,
--0.003967, -0.003937, -0.003906, -0.002411,
+    int Mako_Slot(const tp_chain* C) const { return (C == &Arena->Chain_A) ? 0 : 1; }
+
+    template <typename T> tp_state<T>* Mako_State(const tp_chain* C, int channel)
+    {
+        if constexpr (std::is_same<T, double>::value) return &Arena->State_d[Mako_Slot(C)][channel];
+        else return &Arena->State[Mako_Slot(C)][channel];
+    }
+
+    //R1.02 Fn(State, chain slot) for every channel of both sets.
+    template <typename F> void Mako_State_All(F&& Fn)
+    {
+        for (int c = 0; c < 2; c++)
+        {
+            for (int ch = 0; ch < 2; ch++)
+            {
+                Fn(Arena->State[c][ch], c);
+                Fn(Arena->State_d[c][ch], c);
+            }
+        }
+    }
+
+    //R1.02 ADAA - The drive, asymmetry and chimera shapers can use first order antiderivative anti-aliasing.
+    enum { a_Drive, a_Asym, a_Low, a_High };
+    bool ADAA = false;                      //R1.02 ADAA is on for this block.
+
+    template <typename T> T Mako_FX_AmpSim(T tSample, tp_chain* C, tp_state<T>* S);
+    template <typename T> T Mako_CabSim(T tSample, int channel, tp_chain* C, tp_state<T>* S, int samp);
+    template <typename T> T Mako_Chain_Process(T tSample, int channel, tp_chain* C, tp_state<T>* S, int samp);
+
+    //R1.02 PRESETS - Coefficients for every preset are designed in prepareToPlay.
+    //R1.02 Switching only copies them into the spare chain and starts an equal power crossfade.
+    static const int Preset_Cnt = 8;
+    static const char* const Preset_Names[Preset_Cnt];
+    static const float Preset_Values[Preset_Cnt][17];
+
+    struct tp_preset {
+        tp_filter makoF_HighCut;
+        tp_filter makoF_Band[5];
+        tp_svf makoS_HighCut;
+        tp_svf makoS_Band[5];
+        float IR_Final_VolAdjust;
+        const float* IR_Final;
+        float Set[Setting_Max];
     };
 
-    //R1.00 MarEmi57resample
-    const float IR_Stored_04[1024] = {
-0.034789, 0.10593, 0.243848, 0.452327, 0.692045, 0.893398, 1, 0.952708, 0.667068, 0.133654,
--0.456437, -0.792681, -0.757768, -0.491086, -0.184997, 0.025426, 0.185169, 0.402048, 0.557948, 0.411219,
-0.096193, -0.011811, 0.078531, 0.212111, 0.251866, 0.139535, 0.127717, 0.191542, 0.028964, -0.193583,
--0.144028, -0.015978, -0.038819, -0.035153, 0.059465, 0.093064, -0.025977, -0.168851, -0.114308, 0.052983,
-0.071622, -0.010083, -0.016467, 0.036311, 0.037746, -0.055799, -0.13124, -0.118195, -0.090511, -0.103838,
--0.112272, -0.07488, -0.015424, 0.03432, 0.035695, -0.026254, -0.084495, -0.08859, -0.085306, -0.105386,
--0.11501, -0.070444, -0.022784, -0.051122, -0.124039, -0.156849, -0.135505, -0.133646, -0.152796, -0.127478,
--0.072738, -0.059615, -0.076648, -0.085493, -0.120633, -0.178108, -0.195411, -0.164937, -0.130561, -0.101112,
--0.072541, -0.070778, -0.103013, -0.124169, -0.119648, -0.114532, -0.10124, -0.05684, -0.003778, 0.005116,
--0.025095, -0.05275, -0.060148, -0.067746, -0.094747, -0.114247, -0.10015, -0.077495, -0.085365, -0.124799,
--0.16088, -0.152535, -0.13156, -0.144362, -0.156984, -0.135941, -0.100431, -0.079181, -0.082382, -0.096585,
--0.095111, -0.074212, -0.05688, -0.065008, -0.086388, -0.088531, -0.07169, -0.07705, -0.108013, -0.114619,
--0.085421, -0.063874, -0.075997, -0.092366, -0.082737, -0.067695, -0.081076, -0.107088, -0.103657, -0.067313,
--0.031448, -0.020364, -0.024312, -0.025244, -0.02174, -0.024393, -0.03741, -0.049725, -0.0492, -0.047046,
--0.066527, -0.106708, -0.137605, -0.139984, -0.127656, -0.112555, -0.085773, -0.042982, -0.007963, 0.006711,
-0.012843, 0.012196, -0.006405, -0.037016, -0.065715, -0.081753, -0.082828, -0.07653, -0.064507, -0.04573,
--0.028042, -0.020207, -0.016468, -0.01044, -0.001754, 0.006128, 0.010744, 0.007923, -0.002889, -0.020791,
--0.044912, -0.064735, -0.069089, -0.055995, -0.030556, 0.000198, 0.022531, 0.030338, 0.025276, 0.008955,
--0.018353, -0.045994, -0.058891, -0.056397, -0.0437, -0.026362, -0.009352, 0.002071, 0.003864, -0.002978,
--0.009794, -0.007032, 0.006364, 0.024503, 0.035396, 0.032968, 0.016962, -0.000833, -0.012103, -0.018706,
--0.016086, 0.00115, 0.025021, 0.042842, 0.04956, 0.047021, 0.038076, 0.021095, 0.000071, -0.011422,
--0.002658, 0.021885, 0.050618, 0.072254, 0.081421, 0.077635, 0.060765, 0.03847, 0.02329, 0.020984,
-0.027061, 0.037656, 0.043763, 0.041656, 0.03538, 0.025347, 0.014312, 0.008841, 0.011682, 0.021999,
-0.04096, 0.060277, 0.070483, 0.070207, 0.062716, 0.050344, 0.03721, 0.030462, 0.035015, 0.043911,
-0.048342, 0.052843, 0.059809, 0.062149, 0.060043, 0.060558, 0.063485, 0.065422, 0.064798, 0.062488,
-0.058852, 0.054096, 0.04975, 0.047315, 0.046405, 0.044409, 0.043688, 0.045751, 0.049213, 0.054479,
-0.061417, 0.064228, 0.058623, 0.050313, 0.046746, 0.045868, 0.042579, 0.039435, 0.040658, 0.045242,
-0.048963, 0.05324, 0.059515, 0.066, 0.069883, 0.069719, 0.065198, 0.057843, 0.049634, 0.045382,
-0.047288, 0.053369, 0.061594, 0.069745, 0.073627, 0.07268, 0.069167, 0.066262, 0.064019, 0.063054,
-0.061652, 0.060698, 0.059836, 0.059063, 0.057244, 0.053764, 0.051215, 0.051, 0.053788, 0.056964,
-0.060673, 0.062488, 0.059139, 0.052001, 0.043688, 0.035769, 0.031084, 0.032425, 0.040418, 0.052317,
-0.062471, 0.06921, 0.072203, 0.07166, 0.067272, 0.061501, 0.054881, 0.047973, 0.042911, 0.040153,
-0.038471, 0.03781, 0.040303, 0.043933, 0.046592, 0.048123, 0.049738, 0.052225, 0.054378, 0.055124,
-0.053652, 0.051089, 0.047422, 0.043137, 0.036444, 0.030057, 0.026393, 0.026203, 0.027369, 0.029131,
-0.03194, 0.036128, 0.040483, 0.043196, 0.042627, 0.038954, 0.033704, 0.029436, 0.027186, 0.025835,
-0.023861, 0.023342, 0.024403, 0.023413, 0.019922, 0.017857, 0.018334, 0.020544, 0.023998, 0.028362,
-0.032193, 0.034937, 0.035, 0.032945, 0.029644, 0.026701, 0.02383, 0.021632, 0.020454, 0.020435,
-0.023811, 0.026869, 0.026906, 0.024705, 0.022046, 0.018352, 0.014366, 0.011629, 0.010331, 0.009386,
-0.009192, 0.009655, 0.009929, 0.009297, 0.008307, 0.007238, 0.007396, 0.009956, 0.01323, 0.01566,
-0.016348, 0.014324, 0.011062, 0.006615, 0.001387, -0.002505, -0.003499, -0.001191, 0.003351, 0.008343,
-0.012642, 0.01558, 0.014419, 0.009416, 0.003941, -0.000671, -0.00452, -0.00639, -0.008098, -0.009653,
--0.010245, -0.012773, -0.015815, -0.016185, -0.014399, -0.01054, -0.006046, -0.004803, -0.003425, -0.001219,
--0.002119, -0.0061, -0.010547, -0.01394, -0.016209, -0.018518, -0.020464, -0.019495, -0.017228, -0.017064,
--0.017878, -0.017176, -0.016628, -0.01788, -0.018978, -0.019789, -0.019812, -0.019876, -0.019276, -0.01743,
--0.014606, -0.012882, -0.012848, -0.014169, -0.016248, -0.018631, -0.021876, -0.022787, -0.021244, -0.019861,
--0.019853, -0.018984, -0.018648, -0.019093, -0.020421, -0.022312, -0.022874, -0.02174, -0.021162, -0.022658,
--0.024045, -0.025011, -0.026475, -0.028743, -0.030354, -0.028845, -0.024937, -0.021693, -0.020223, -0.019057,
--0.019216, -0.020032, -0.022261, -0.023994, -0.023991, -0.023189, -0.022125, -0.021305, -0.020492, -0.020275,
--0.020045, -0.020563, -0.020403, -0.020619, -0.020103, -0.018712, -0.017632, -0.018297, -0.020401, -0.023083,
--0.02699, -0.030211, -0.031878, -0.031441, -0.029344, -0.025919, -0.022349, -0.020355, -0.019527, -0.019702,
--0.020027, -0.021552, -0.023576, -0.025237, -0.025545, -0.025113, -0.02413, -0.022398, -0.020137, -0.017768,
--0.017267, -0.018025, -0.018156, -0.018607, -0.019633, -0.020629, -0.021806, -0.02238, -0.022843, -0.023237,
--0.023115, -0.021875, -0.019982, -0.018259, -0.016488, -0.014801, -0.013181, -0.012871, -0.0138, -0.016057,
--0.018299, -0.019687, -0.020475, -0.020593, -0.019947, -0.018735, -0.018685, -0.019093, -0.020003, -0.020725,
--0.020899, -0.02001, -0.017632, -0.015044, -0.013356, -0.013001, -0.013296, -0.014362, -0.015651, -0.015969,
--0.014913, -0.013305, -0.011985, -0.011261, -0.010646, -0.010846, -0.01248, -0.013749, -0.014375, -0.013906,
--0.012984, -0.011802, -0.011031, -0.010687, -0.010195, -0.010121, -0.009626, -0.00833, -0.006684, -0.005839,
--0.00532, -0.005801, -0.006058, -0.007059, -0.008519, -0.009437, -0.009653, -0.009568, -0.009274, -0.008373,
--0.008118, -0.007958, -0.007577, -0.007004, -0.006946, -0.007082, -0.00782, -0.008234, -0.008722, -0.008903,
--0.00884, -0.008096, -0.006691, -0.005332, -0.003981, -0.003, -0.002693, -0.0027, -0.003203, -0.004091,
--0.004968, -0.00511, -0.004812, -0.005023, -0.005097, -0.005046, -0.004915, -0.005365, -0.006487, -0.007731,
--0.008637, -0.009474, -0.009738, -0.009881, -0.009739, -0.008542, -0.006631, -0.004374, -0.0031, -0.003147,
--0.003735, -0.004205, -0.005122, -0.005791, -0.005838, -0.004928, -0.004097, -0.003442, -0.00316, -0.003468,
--0.003532, -0.004046, -0.004348, -0.004194, -0.004139, -0.004023, -0.003552, -0.003573, -0.00364, -0.003935,
--0.004171, -0.004214, -0.004082, -0.004014, -0.004143, -0.004034, -0.004066, -0.00344, -0.002859, -0.002078,
--0.001854, -0.001945, -0.001901, -0.002505, -0.003262, -0.003637, -0.003442, -0.003551, -0.003639, -0.003438,
--0.002511, -0.001829, -0.001689, -0.001468, -0.001568, -0.00124, -0.002365, -0.003261, -0.003481, -0.00265,
--0.001108, 0.000717, 0.001903, 0.002597, 0.002832, 0.002491, 0.002012, 0.001249, 0.000616, 0.000355,
--0.000328, -0.001195, -0.002093, -0.002318, -0.001913, -0.001813, -0.001509, -0.000956, -0.000363, -0.00035,
--0.000951, -0.001054, -0.001181, -0.001538, -0.002158, -0.001914, -0.0007, 0.001266, 0.002938, 0.003917,
-0.004338, 0.003434, 0.000672, -0.00222, -0.003462, -0.003126, -0.002138, -0.000509, 0.001451, 0.00362,
-0.004923, 0.004708, 0.003273, 0.002092, 0.001464, 0.001242, 0.001302, 0.001772, 0.002835, 0.003229,
-0.002248, 0.001714, 0.00225, 0.00337, 0.004448, 0.005205, 0.006187, 0.007102, 0.00669, 0.004438,
-0.002123, 0.000771, 0.000182, -0.000192, 0.000481, 0.002255, 0.003698, 0.004618, 0.005068, 0.005492,
-0.005221, 0.003723, 0.002282, 0.002163, 0.002137, 0.001817, 0.001026, 0.00192, 0.003151, 0.004637,
-0.005462, 0.006126, 0.006172, 0.006131, 0.005504, 0.004038, 0.002743, 0.002507, 0.002153, 0.00176,
-0.002233, 0.003361, 0.004017, 0.003888, 0.003628, 0.003603, 0.002893, 0.001749, 0.001429, 0.00205,
-0.002317, 0.002281, 0.00245, 0.003079, 0.003476, 0.002926, 0.001603, 0.000725, 0.000899, 0.001296,
-0.001582, 0.002425, 0.004311, 0.005707, 0.004786, 0.00338, 0.001336, 0.000151, 0.00004, 0.001282,
-0.003017, 0.003995, 0.003138, 0.00096, -0.000616, -0.001182, -0.000795, 0.00054, 0.002009, 0.003452,
-0.004288, 0.003953, 0.00222, 0.000371, -0.000959, -0.001465, -0.001129, -0.000117, 0.000794, 0.001278,
-0.000674, -0.000799, -0.002041, -0.00236, -0.001101, 0.001277, 0.004425, 0.007188, 0.008348, 0.00677,
-0.004004, 0.001697, -0.00017, -0.000921, -0.000649, 0.000411, 0.001953, 0.003061, 0.003534, 0.00319,
-0.002137, 0.000036, -0.001618, -0.00193, -0.001059, 0.000567, 0.002417, 0.004647, 0.006428, 0.006899,
-0.006994, 0.006418, 0.006295, 0.006033, 0.005582, 0.004349, 0.002827, 0.001248, -0.000633, -0.002779,
--0.004445, -0.004697, -0.002858, 0.000027, 0.002829, 0.005427, 0.007866, 0.008808, 0.007934, 0.005511,
-0.002348, -0.000246, -0.001527, -0.001422, 0.000046, 0.001891, 0.003301, 0.003541, 0.002799, 0.001845,
-0.00009, -0.001304, -0.001697, -0.001142, 0.000381, 0.001161, 0.001096, 0.000935, 0.001459, 0.001659,
-0.001254, 0.000718, 0.000059, -0.000156, -0.001291, -0.002309, -0.003192, -0.002796, -0.001726, -0.000417,
-0.001105, 0.002245, 0.002955, 0.00201, -0.001218, -0.004811, -0.007101, -0.008659, -0.008872, -0.007354,
--0.004313, -0.000306, 0.002472, 0.003815, 0.003769, 0.003065, 0.001558, -0.000089, -0.001419, -0.001986,
--0.001894, -0.001792, -0.001452, -0.00112, -0.000216, 0.000814, 0.00201, 0.003012, 0.003751, 0.003548,
-0.00247, 0.00054, -0.001521, -0.002797, -0.002515, -0.000246, 0.002676, 0.005013, 0.005835, 0.005806,
-0.004051, 0.00167, -0.000547, -0.001396, -0.000603, 0.000553, 0.001419, 0.002334, 0.00359, 0.004483,
-0.003927, 0.002771, 0.002134, 0.002062, 0.001865, 0.002474, 0.002244, 0.000941, -0.001306, -0.002922,
--0.003862, -0.003676, -0.00173, 0.000446, 0.001807, 0.00248, 0.003434, 0.003422, 0.003538, 0.003448,
-0.004224, 0.005179, 0.005043, 0.003851, 0.002213, 0.000277, -0.00222, -0.004191, -0.004909, -0.004176,
--0.0027, -0.00061, 0.001272, 0.003053, 0.003939, 0.003358, 0.003318, 0.003122, 0.002977, 0.002341,
-0.001581, 0.000566, -0.00091, -0.00258, -0.003585, -0.003649, -0.002648, -0.00067, 0.001604, 0.003365,
-0.004192, 0.004021, 0.002896, 0.001211, -0.00054, -0.002183, -0.003841, -0.005032, -0.004871, -0.003867,
--0.002108, -0.001142, -0.000528, -0.000704, -0.001365, -0.001802, -0.002152, -0.001871, -0.001353, -0.001027,
--0.001007, -0.001631, -0.002666, -0.003538, -0.003718, -0.003414, -0.002714, -0.002433, -0.001714, -0.001622,
--0.001784, -0.002206, -0.002859, -0.00289,
+    bool Preset_Ready = false;
+    std::atomic<int> Preset_Current { 0 };  //R1.02 Only the audio thread writes it, in Mako_Preset_Switch.
+    std::atomic<int> Preset_Switches { 0 }; //R1.02 Switches done. The timer pushes the knobs when it moves.
+    int Preset_Shown = 0;                   //R1.02 Message thread. Preset_Switches the knobs show.
+    std::atomic<int> Preset_Pending { -1 };
+    int Preset_FadePos = 0;
+    int Preset_FadeLen = 1;
+    std::vector<float> Preset_Fade;         //R1.02 Quarter sine. Sized in prepareToPlay.
+
+    void Mako_Preset_Design(tp_preset* P, const float* Values, float Fs);
+    void Mako_Preset_Load(tp_chain* C, const tp_preset* P);
+    void Mako_Preset_Switch(int Index);
+    void timerCallback() override { Mako_Preset_Follow(); Mako_Threads_Follow(); Mako_Profile_Follow(); }
+
+    //R1.02 MULTI CORE - A persistent worker runs channel 1 while the audio thread runs channel 0.
+    //R1.02 It spins for a while after each block before sleeping, so back to back blocks do not pay for a wake up.
+    class tp_worker : public juce::Thread
+    {
+    public:
+        tp_worker(MakoBiteAudioProcessor& p) : juce::Thread("Mako Rusty Worker"), Proc(p) {}
+        void run() override;
+
+        MakoBiteAudioProcessor& Proc;
+        std::atomic<int> Job_Posted { 0 };
+        std::atomic<int> Job_Done { 0 };
+        std::atomic<int> Job_Claimed { 0 };    //R1.02 Whoever moves this to the job number runs it, worker or audio thread.
+        std::atomic<bool> Sleeping { false };
+        MakoWake Wake;                      //R1.02 Not notify(), that locks a mutex on the audio thread.
+        float* Job_Data = nullptr;          //R1.02 One of these is set.
+        double* Job_Data_d = nullptr;
+        int Job_Samples = 0;
     };
 
+    std::unique_ptr<tp_worker> Worker;
+    std::atomic<tp_worker*> Worker_Ready { nullptr };   //R1.02 Only set once the worker got realtime priority.
+    bool Worker_Tried = false;
+    static const int Worker_Spins = 20000;       //R1.02 Spin about one block at 48k/128 before sleeping.
+    static const int Worker_MinSamples = 32;     //R1.02 Tiny blocks are not worth the hand off.
+    static constexpr double Worker_WaitFrac = .25;   //R1.02 Wait at most this part of the block, then do channel 1 here.
+    template <typename T> void Mako_Process_Channel(T* channelData, int channel, int numSamples);
+
+    //R1.02 CAB POOL - The cab IR taps past Tail_Head are done one block early by the shared pool.
+    //R1.02 Jobs are [chain][channel] so a preset fade can use the old chain result too.
+    //R1.02 The pool is joined the first time Cab Pool is on, so instances that never use it start no threads.
+    std::unique_ptr<juce::SharedResourcePointer<MakoPool>> Pool_Ref;
+    std::atomic<MakoPool*> Pool { nullptr };
+    MakoTailJob Tail_Jobs[2][2];
+    bool Tail_Use[2][2] = {};               //R1.02 This block has a pool result for the chain and channel.
+    int Tail_Head = 256;
+    template <typename T> void Mako_Tail_Begin(tp_chain* C, int channel, int numSamples);
+    template <typename T> void Mako_Tail_Post(tp_chain* C, int channel, int numSamples);
+    template <typename T> void Mako_Tail_Advance(int channel, int numSamples);
+
+    //R1.02 IR BLEND - ir and ir2 are mixed into one kernel by a background thread, so two cabs cost the same as one.
+    //R1.02 The audio thread owns Kernel_Front and Kernel_Spare, the builder owns Kernel_Back,
+    //R1.02 and Kernel_Middle is handed between them with Kernel_New set when it holds a fresh kernel.
+    float Kernels[4][1024];
+    int Kernel_Front = 0;
+    int Kernel_Spare = 1;
+    int Kernel_Back = 2;
+    std::atomic<int> Kernel_Middle { 3 };
+    static const int Kernel_New = 8;
+    std::atomic<int> Blend_Request { -1 };
+    float Blend_Last[2] = { -1.0f, -1.0f };
+    bool Blend_On = false;
+    juce::CriticalSection Blend_Lock;       //R1.02 Builder thread vs prepareToPlay. Never taken on the audio thread.
+
+    class tp_builder : public juce::Thread
+    {
+    public:
+        tp_builder(MakoBiteAudioProcessor& p) : juce::Thread("Mako Rusty Kernel"), Proc(p) {}
+        void run() override;
+        MakoBiteAudioProcessor& Proc;
+        MakoWake Wake;                      //R1.02 Signaled by our timer. The audio thread never wakes the builder.
+    };
+    static const int Builder_WaitMs = 1000; //R1.02 Only a safety net, the timer wakes the builder when a request is posted.
+
+    std::unique_ptr<tp_builder> Builder;
+    void Mako_Blend_Build(int Request);
+    void Mako_Blend_Poll(bool Now);
+    void Mako_IR_Fade(tp_chain* C, const float* IR, float Vol, bool Now);
+
+    //R1.02 ECO CAB - Each IR fitted to a gain and 12 peaking biquads. Far cheaper than 1024 taps.
+    //R1.02 The fit is done off the audio thread the first time eco is on, once per sample rate.
+    static const int Eco_Bands = 12;
+    static const int Eco_Points = 96;
+    tp_filter Eco_Coeffs[6][Eco_Bands] = {};
+    float Eco_Gain[6] = {};
+    float Eco_FitRate = 0.0f;
+    std::atomic<bool> Eco_Ready { false };  //R1.02 The fit is for our sample rate. Eco stays off until it is.
+    bool Eco = false;                       //R1.02 Eco is on for this block.
+    bool Eco_Last = false;
+    void Mako_Eco_Fit();
+    void Mako_Eco_FitModel(int Model);
+    void Mako_Eco_Load(tp_chain* C);
+    template <typename T> T Mako_CabEco(T tSample, tp_chain* C, tp_state<T>* S);
+
+    //R1.02 OFFLINE HQ - When the host bounces we oversample the amp by the offline parameter and always use the full IR.
+    //R1.02 Playback goes back to the realtime profile. Both profiles are designed off the audio thread, in prepareToPlay
+    //R1.02 and when Offline HQ changes. setNonRealtime only sets Profile_Want, processBlock points at the one it wants.
+    struct tp_profile {
+        bool NonRealtime;                   //R1.02 Bounce profile. No eco and no governor, whatever Offline HQ is.
+        bool Offline;                       //R1.02 Oversampled.
+        int OS_Factor;
+        float Amp_Rate;
+        float Svf_Glide;
+        int Latency;
+        float OS_Coeffs[OS_Taps * OS_Max];
+        tp_filter makoF_HighPass;           //R1.02 The fixed amp filters, copied into both chains.
+        tp_filter makoF_ChimeraLow;
+        tp_filter makoF_ChimeraHigh;
+        tp_svf makoS_HighPass;
+        tp_preset Presets[Preset_Cnt];
+    };
 
-    //R1.00 Mako RR 01B
-    const float IR_Stored_05[1024] = {
-   0.056122, 0.300873, 0.705597, 0.992645, 0.999969, 0.775543, 0.386292, -0.034119, -0.350616, -0.523407,
-   -0.52771, -0.39505, -0.19809, 0.008148, 0.165436, 0.255585, 0.281342, 0.25177, 0.199402, 0.143707,
-   0.101807, 0.077515, 0.060638, 0.043396, 0.011749, -0.031342, -0.082672, -0.139557, -0.188782, -0.225891,
-   -0.24353, -0.243927, -0.231445, -0.205994, -0.176758, -0.144836, -0.11615, -0.095856, -0.081055, -0.073853,
-   -0.068542, -0.065216, -0.065948, -0.069305, -0.075867, -0.079987, -0.083069, -0.08667, -0.091644, -0.100311,
-   -0.109283, -0.1185, -0.123322, -0.121033, -0.112793, -0.098297, -0.083801, -0.071167, -0.061584, -0.055573,
-   -0.050934, -0.048889, -0.046844, -0.045319, -0.044861, -0.046478, -0.053345, -0.062836, -0.074432, -0.085205,
-   -0.092651, -0.096405, -0.093811, -0.087067, -0.077454, -0.067993, -0.062134, -0.060028, -0.063049, -0.067963,
-   -0.072388, -0.073212, -0.067871, -0.058136, -0.044922, -0.032227, -0.021759, -0.014862, -0.013367, -0.016083,
-   -0.023499, -0.03299, -0.042511, -0.050079, -0.052917, -0.051697, -0.045685, -0.03717, -0.02887, -0.022156,
-   -0.019196, -0.018524, -0.019684, -0.020325, -0.018738, -0.015289, -0.009735, -0.004761, -0.000946, 0.00116,
-   0.001251, 0.000977, -0.000275, -0.001587, -0.003754, -0.007019, -0.010406, -0.014069, -0.016052, -0.016296,
-   -0.014252, -0.010437, -0.006378, -0.001892, 0.00174, 0.005157, 0.00827, 0.010498, 0.012207, 0.012207,
-   0.011322, 0.009613, 0.007874, 0.007202, 0.007324, 0.008759, 0.01001, 0.010468, 0.009857, 0.008057,
-   0.006348, 0.004791, 0.004425, 0.005188, 0.006805, 0.009521, 0.012421, 0.015991, 0.019409, 0.022339,
-   0.024628, 0.025482, 0.025604, 0.025085, 0.025024, 0.026031, 0.027802, 0.030334, 0.032013, 0.032562,
-   0.031433, 0.028992, 0.026337, 0.024109, 0.023529, 0.024384, 0.026123, 0.028107, 0.029388, 0.030396,
-   0.030823, 0.031433, 0.032196, 0.032928, 0.033722, 0.033813, 0.033844, 0.033722, 0.033966, 0.03479,
-   0.035675, 0.036713, 0.03717, 0.03717, 0.036774, 0.035858, 0.035217, 0.034668, 0.034576, 0.034454,
-   0.034149, 0.033905, 0.033569, 0.033875, 0.034637, 0.03598, 0.037628, 0.038879, 0.039764, 0.039795,
-   0.039368, 0.038696, 0.037964, 0.037537, 0.036987, 0.036499, 0.03595, 0.035309, 0.03479, 0.034088,
-   0.0336, 0.032959, 0.032043, 0.030701, 0.028839, 0.027008, 0.02536, 0.024384, 0.02417, 0.024445,
-   0.025024, 0.025421, 0.025635, 0.025604, 0.025482, 0.025543, 0.025421, 0.025208, 0.024597, 0.023865,
-   0.023163, 0.022705, 0.022766, 0.023102, 0.023651, 0.023895, 0.023651, 0.022888, 0.021667, 0.020447,
-   0.019409, 0.018768, 0.018585, 0.018707, 0.019196, 0.019958, 0.020996, 0.022156, 0.023254, 0.024139,
-   0.024506, 0.024323, 0.023621, 0.022644, 0.021729, 0.020905, 0.020325, 0.019775, 0.019135, 0.018341,
-   0.017456, 0.016693, 0.016022, 0.015625, 0.015381, 0.015228, 0.015045, 0.01474, 0.014557, 0.014496,
-   0.014801, 0.015411, 0.016083, 0.016632, 0.016785, 0.016479, 0.015717, 0.014618, 0.013428, 0.012177,
-   0.011047, 0.010071, 0.009186, 0.008514, 0.007996, 0.007599, 0.007324, 0.006989, 0.006561, 0.006104,
-   0.005676, 0.005371, 0.005463, 0.00592, 0.006683, 0.007629, 0.008423, 0.00882, 0.008759, 0.00827,
-   0.007477, 0.006683, 0.006012, 0.005524, 0.005096, 0.004669, 0.004089, 0.003418, 0.002838, 0.002289,
-   0.002014, 0.001923, 0.002014, 0.002167, 0.002258, 0.002258, 0.002167, 0.002136, 0.002136, 0.002136,
-   0.002075, 0.001953, 0.00174, 0.001465, 0.001129, 0.000916, 0.00061, 0.000275, -0.000336, -0.001068,
-   -0.00177, -0.002319, -0.002441, -0.002197, -0.001556, -0.000793, -0.000153, 0.000275, 0.000305, 0.000092,
-   -0.000366, -0.000824, -0.001221, -0.001587, -0.001801, -0.001984, -0.002167, -0.002319, -0.002625, -0.002991,
-   -0.003632, -0.004395, -0.005219, -0.00592, -0.006226, -0.006165, -0.005676, -0.005035, -0.004486, -0.00412,
-   -0.004059, -0.004059, -0.004181, -0.004211, -0.004211, -0.004364, -0.0047, -0.00531, -0.006012, -0.006744,
-   -0.007294, -0.007538, -0.00769, -0.00766, -0.007721, -0.007813, -0.007904, -0.007996, -0.007874, -0.007751,
-   -0.007507, -0.007355, -0.007294, -0.007233, -0.007263, -0.007111, -0.006989, -0.006927, -0.007019, -0.007507,
-   -0.008118, -0.008972, -0.009674, -0.010162, -0.010406, -0.010376, -0.010406, -0.010437, -0.01062, -0.010925,
-   -0.011108, -0.011261, -0.011078, -0.010773, -0.010315, -0.009796, -0.00943, -0.009003, -0.008759, -0.008484,
-   -0.008392, -0.008453, -0.008636, -0.009003, -0.009277, -0.009491, -0.00943, -0.009155, -0.00885, -0.008514,
-   -0.008423, -0.008423, -0.008514, -0.008606, -0.008484, -0.008301, -0.007935, -0.007599, -0.007294, -0.00705,
-   -0.007019, -0.006927, -0.00705, -0.007202, -0.007477, -0.007996, -0.008484, -0.009094, -0.009491, -0.009705,
-   -0.009766, -0.009644, -0.009674, -0.009583, -0.009644, -0.009644, -0.009491, -0.009399, -0.009094, -0.008972,
-   -0.00885, -0.00885, -0.008942, -0.008881, -0.00885, -0.008636, -0.008484, -0.008453, -0.008575, -0.008942,
-   -0.009338, -0.009766, -0.010071, -0.010284, -0.010529, -0.010651, -0.010895, -0.011047, -0.011169, -0.011169,
-   -0.010986, -0.010895, -0.010681, -0.010651, -0.01059, -0.010559, -0.010559, -0.010406, -0.010254, -0.01001,
-   -0.009827, -0.009766, -0.009705, -0.009735, -0.009674, -0.009674, -0.009613, -0.009583, -0.009705, -0.009735,
-   -0.009888, -0.009979, -0.009949, -0.009888, -0.009705, -0.009613, -0.00946, -0.009399, -0.009247, -0.009003,
-   -0.008728, -0.008331, -0.008026, -0.007782, -0.00769, -0.007751, -0.007843, -0.008057, -0.008179, -0.00827,
-   -0.008362, -0.008392, -0.008545, -0.008636, -0.00882, -0.008881, -0.008942, -0.008972, -0.00882, -0.008728,
-   -0.008514, -0.008209, -0.007904, -0.007416, -0.006989, -0.00647, -0.006073, -0.005768, -0.005585, -0.005585,
-   -0.005585, -0.005737, -0.00592, -0.006134, -0.006409, -0.006683, -0.00705, -0.007355, -0.007629, -0.007843,
-   -0.007935, -0.007935, -0.007813, -0.00769, -0.007446, -0.007202, -0.006897, -0.006439, -0.005951, -0.005371,
-   -0.004822, -0.004272, -0.003754, -0.003357, -0.003021, -0.002869, -0.002869, -0.003052, -0.003357, -0.003723,
-   -0.004028, -0.004181, -0.004181, -0.004028, -0.003723, -0.003448, -0.003143, -0.002899, -0.002655, -0.002319,
-   -0.001953, -0.001526, -0.001129, -0.000732, -0.000397, -0.000183, 0, 0.000031, -0.000092, -0.000305,
-   -0.000641, -0.001038, -0.001495, -0.001831, -0.002075, -0.002136, -0.002014, -0.001801, -0.001495, -0.00116,
-   -0.000824, -0.000366, 0.000092, 0.000641, 0.00119, 0.001709, 0.002045, 0.002289, 0.002411, 0.002472,
-   0.002502, 0.002472, 0.002319, 0.002075, 0.001709, 0.001251, 0.000793, 0.000427, 0.000122, 0,
-   0.000061, 0.000244, 0.000488, 0.000824, 0.00119, 0.001556, 0.001892, 0.002197, 0.002411, 0.002472,
-   0.002441, 0.002319, 0.002106, 0.001892, 0.001617, 0.001343, 0.000977, 0.000549, 0.000061, -0.000397,
-   -0.000793, -0.001099, -0.00119, -0.00116, -0.001007, -0.000702, -0.000336, 0.000122, 0.00058, 0.001038,
-   0.001434, 0.001678, 0.001831, 0.00177, 0.001648, 0.001495, 0.001221, 0.000977, 0.000671, 0.000305,
-   -0.000061, -0.000427, -0.000702, -0.000885, -0.000916, -0.000854, -0.000671, -0.000427, -0.000122, 0.000275,
-   0.000702, 0.00119, 0.001709, 0.002136, 0.002502, 0.002716, 0.002777, 0.002686, 0.002502, 0.002258,
-   0.001923, 0.001587, 0.001099, 0.000671, 0.000305, -0.000031, -0.000122, -0.000183, -0.000092, 0.000092,
-   0.000244, 0.000427, 0.00061, 0.000793, 0.000946, 0.001068, 0.00116, 0.00116, 0.001129, 0.001007,
-   0.000885, 0.000702, 0.000458, 0.000244, -0.000061, -0.000336, -0.00061, -0.000763, -0.000732, -0.00061,
-   -0.000275, 0.000122, 0.00061, 0.001068, 0.001495, 0.001923, 0.002258, 0.002625, 0.002899, 0.003052,
-   0.003143, 0.003052, 0.00293, 0.002625, 0.002319, 0.001923, 0.001434, 0.001007, 0.000549, 0.000214,
-   -0.000061, -0.000183, -0.000183, -0.000122, 0.000092, 0.000336, 0.000641, 0.001007, 0.001312, 0.00174,
-   0.001984, 0.002258, 0.00238, 0.002411, 0.00238, 0.002197, 0.002014, 0.00177, 0.001495, 0.001251,
-   0.001007, 0.000854, 0.000671, 0.000641, 0.000641, 0.000763, 0.001007, 0.001251, 0.001709, 0.002136,
-   0.002625, 0.003113, 0.003479, 0.003815, 0.003906, 0.003906, 0.003784, 0.003571, 0.003326, 0.003021,
-   0.002777, 0.002502, 0.002228, 0.002014, 0.001678, 0.001465, 0.00119, 0.001068, 0.000977, 0.000916,
-   0.001099, 0.001282, 0.001556, 0.001892, 0.002136, 0.00238, 0.002472, 0.002533, 0.002411, 0.002228,
-   0.001984, 0.001648, 0.001343, 0.000946, 0.00061, 0.000275, -0.000061, -0.000336, -0.00061, -0.000671,
-   -0.000732, -0.000671, -0.000549, -0.000427, -0.000183, -0.000031, 0.000153, 0.000336, 0.000519, 0.000732,
-   0.000885, 0.001099, 0.001221, 0.001251, 0.001221, 0.001038, 0.000824, 0.00058, 0.000366, 0.000214,
-   0.000122, 0.000122, 0.000153, 0.000305, 0.000427, 0.000549, 0.000732, 0.000854, 0.001038, 0.001129,
-   0.001251, 0.001312, 0.001343, 0.001404, 0.001373, 0.001343, 0.001221, 0.001038, 0.000793, 0.000458,
-   0.000183, -0.000122, -0.000366, -0.000549, -0.000671, -0.000702, -0.000702, -0.00061, -0.000488, -0.000336,
-   -0.000061, 0.000153, 0.000427, 0.000671, 0.000885, 0.001099, 0.001221, 0.001343, 0.001404, 0.001434,
-   0.001465, 0.001434, 0.001434, 0.001343, 0.001251, 0.001129, 0.001038, 0.000946, 0.000854, 0.000824,
-   0.000793, 0.000854, 0.000946, 0.001038, 0.00116, 0.001221, 0.001312, 0.001343, 0.001373, 0.001404,
-   0.001434, 0.001465, 0.001434, 0.001434, 0.001404, 0.001312, 0.001221, 0.001038, 0.000885, 0.000702,
-   0.000519, 0.000397, 0.000305, 0.000305, 0.000305, 0.000397, 0.000458, 0.000549, 0.000641, 0.000732,
-   0.000854, 0.000977, 0.001129, 0.001251, 0.001404, 0.001526, 0.001587, 0.001678, 0.00174, 0.00177,
-   0.00177, 0.001709, 0.001648, 0.001556, 0.001495, 0.001434, 0.001404, 0.001404, 0.001404, 0.001434,
-   0.001434, 0.001465, 0.001495, 0.001526, 0.001587, 0.001617, 0.001678, 0.001709, 0.001801, 0.001862,
-   0.001923, 0.001953, 0.001923, 0.001892, 0.001801, 0.001678, 0.001587, 0.001465, 0.001373, 0.001282,
-   0.001221, 0.001129, 0.001038, 0.001007, 0.000916, 0.000854, 0.000763, 0.000702, 0.000671, 0.00061,
-   0.00061, 0.000641, 0.000671, 0.000732, 0.000732, 0.000763, 0.000702, 0.000671, 0.000641, 0.00061,
-   0.00061, 0.00058, 0.00061, 0.00061, 0.00061, 0.000671, 0.000702, 0.000793, 0.000793, 0.000885,
-   0.000916, 0.000916, 0.000946, 0.000916, 0.000946, 0.000916, 0.000916, 0.000916, 0.000854, 0.000854,
-   0.000763, 0.000732, 0.000671, 0.00058, 0.000519, 0.000366, 0.000305, 0.000214, 0.000214, 0.000244,
-   0.000305, 0.000458, 0.000549, 0.000671, 0.000732, 0.000732, 0.000793, 0.000793, 0.000885, 0.000885,
-   0.000946, 0.000977, 0.000946, 0.001007, 0.000946, 0.000946, 0.000946, 0.000885, 0.000916, 0.000885,
-   0.000946, 0.000977, 0.001007, 0.001129, 0.001129, 0.001221, 0.001251, 0.001312, 0.001373, 0.001373,
-   0.001465, 0.001465, 0.001526, 0.001495, 0.001404, 0.001373, 0.001251, 0.001221, 0.001129, 0.001068,
-   0.001038, 0.000946, 0.000946, 0.000854,
+    std::atomic<int> Profile_Want { 0 };    //R1.02 Set off the audio thread. 1 for offline.
+    enum { e_OwnerFree, e_OwnerAudio, e_OwnerDesign };
+    std::atomic<int> Offline_Owner { e_OwnerFree };     //R1.02 Who has Profiles[1], the audio thread playing it or the message thread designing it.
+    int Offline_Parm = -1;                  //R1.02 The Offline HQ setting Profiles[1] was designed for.
+    bool NonRealtime = false;
+    bool Offline = false;
+    void Mako_Profile_Design(tp_profile* P, bool IsOffline);
+    void Mako_Profile_Use(int Index);
+    void Mako_OS_Design(tp_profile* P);
+    template <typename T> T Mako_Amp_Oversampled(T tSample, tp_chain* C, tp_state<T>* S);
+
+    //R1.02 The arena. The chains hold the coefficients every sample reads, so they sit with the state.
+    //R1.02 new tp_arena() value initialises it, which writes every page before the first block.
+    struct tp_arena {
+        tp_dyn Dyn[2];                      //R1.02 Gate and compressor by channel.
+        tp_chain Chain_A;                   //R1.02 Chain slot 0.
+        tp_chain Chain_B;                   //R1.02 Chain slot 1.
+        tp_state<float> State[2][2];        //R1.02 Amp and cab by [chain slot][channel].
+        tp_state<double> State_d[2][2];     //R1.02 The same for 64 bit hosts.
+        tp_profile Profiles[2];             //R1.02 Realtime, offline. Every preset, read when switching.
     };
 
+    std::unique_ptr<tp_arena> Arena { new tp_arena() };
+    bool Arena_Locked = false;
+    void Mako_Arena_Prepare();
+    tp_chain* Chain = &Arena->Chain_A;      //R1.02 The chain we are playing.
+    tp_chain* Chain_Old = nullptr;          //R1.02 The chain we are fading out of. Null when not fading.
+    const tp_profile* Profile = &Arena->Profiles[0];    //R1.02 Audio thread. The profile we are designed for.
+
+    //R1.02 GOVERNOR - Every processBlock is timed against its deadline (numSamples / SampleRate).
+    //R1.02 Running close to the deadline steps the quality down: IR length, then a faster tanh.
+    //R1.02 Plenty of headroom for a while steps it back up. IR length changes fade the end of the IR.
+    struct tp_govlevel {
+        int IR_Taps;
+        bool Tanh_Fast;
+    };
+    static const tp_govlevel Gov_Table[Gov_Levels];
+    int Gov_Level = 0;
+    float Gov_Load = 0.0f;                  //R1.02 Smoothed fraction of the deadline we use.
+    int Gov_HoldHigh = 0;                   //R1.02 Samples the load has been above Gov_High.
+    int Gov_HoldLow = 0;                    //R1.02 Samples the load has been below Gov_Low.
+    std::atomic<int> Gov_Force { -1 };
+    static constexpr float Gov_High = .70f;
+    static constexpr float Gov_Low = .30f;
+    bool Tanh_Fast = false;
+    int Cab_Keep = 1024;                    //R1.02 IR taps always used.
+    int Cab_Taps = 1024;                    //R1.02 IR taps calculated. Taps from Cab_Keep up are being faded.
+    float Cab_Fade0 = 1.0f;                 //R1.02 Gain of the faded taps at the start and end of the fade.
+    float Cab_Fade1 = 1.0f;
+    int Cab_FadePos = 0;
+    void Mako_Gov_Update(double Seconds, int numSamples);
+    void Mako_Gov_SetLevel(int Level);
+    template <typename T> T Mako_Tanh(T x) const;
 
 };
@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+    Realtime safety checker. Reports allocations, locks and blocking calls
+    made while the audio thread (or a thread doing audio work) is inside
+    processBlock.
+
+  ==============================================================================
+*/
+
+#include "PluginRTCheck.h"
+
+#if MAKO_RTCHECK
+
+#if JUCE_LINUX
+ #include <dlfcn.h>
+ #include <execinfo.h>
+ #include <unistd.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <poll.h>
+ #include <sys/select.h>
+ #include <fcntl.h>
+ #include <cstdarg>
+#endif
+
+//R1.02 Plain TLS in the executable, so reading it never allocates.
+static thread_local int RT_Depth __attribute__((tls_model("initial-exec"))) = 0;
+static thread_local bool RT_Reporting __attribute__((tls_model("initial-exec"))) = false;
+static std::atomic<bool> RT_Armed { false };
+static std::atomic<int> RT_Violations { 0 };
+
+//R1.02 One entry per call stack. Filled without locks, each stack is printed the first time only.
+struct tp_rtsite {
+    std::atomic<juce::uint64> Hash { 0 };
+    std::atomic<int> Count { 0 };
+    const char* What = nullptr;
+};
+static const int RT_Site_Max = 256;
+static tp_rtsite RT_Sites[RT_Site_Max];
+static std::atomic<int> RT_Site_Cnt { 0 };
+
+void MakoRTCheck::Arm(bool On) { RT_Armed.store(On); }
+void MakoRTCheck::Enter() { RT_Depth++; }
+void MakoRTCheck::Leave() { RT_Depth--; }
+int MakoRTCheck::Violations() { return RT_Violations.load(); }
+int MakoRTCheck::Sites() { return juce::jmin(RT_Site_Cnt.load(), RT_Site_Max); }
+
+#if JUCE_LINUX
+
+//R1.02 Print straight to stderr. No stdio buffers, no allocation.
+static void Mako_RT_Print(const char* Fmt, ...)
+{
+    char Line[256];
+    va_list Args;
+    va_start(Args, Fmt);
+    int Len = vsnprintf(Line, sizeof(Line), Fmt, Args);
+    va_end(Args);
+    if (0 < Len) (void) ::write(2, Line, size_t(juce::jmin(Len, int(sizeof(Line)) - 1)));
+}
+
+//R1.02 Called by every wrapper. Returns quickly unless we are armed and inside processBlock.
+static void Mako_RT_Violation(const char* What)
+{
+    if ((RT_Depth <= 0) || RT_Reporting || ! RT_Armed.load(std::memory_order_relaxed)) return;
+    RT_Reporting = true;
+    RT_Violations.fetch_add(1);
+
+    void* Frames[32];
+    int n = backtrace(Frames, 32);
+
+    //R1.02 Skip our own frame so the same caller always hashes the same.
+    juce::uint64 Hash = 1469598103934665603ull;
+    for (int f = 1; f < n; f++) Hash = (Hash ^ juce::uint64(reinterpret_cast<juce::pointer_sized_int>(Frames[f]))) * 1099511628211ull;
+    if (Hash == 0) Hash = 1;
+
+    for (int s = 0; s < RT_Site_Max; s++)
+    {
+        tp_rtsite& Site = RT_Sites[(Hash + juce::uint64(s)) % RT_Site_Max];
+        juce::uint64 Expect = 0;
+        if (Site.Hash.compare_exchange_strong(Expect, Hash))
+        {
+            Site.What = What;
+            Site.Count.fetch_add(1);
+            RT_Site_Cnt.fetch_add(1);
+            Mako_RT_Print("\nMakoRTCheck: %s on an audio thread. Stack:\n", What);
+            backtrace_symbols_fd(Frames + 1, n - 1, 2);
+            break;
+        }
+        if (Expect == Hash)
+        {
+            Site.Count.fetch_add(1);
+            break;
+        }
+    }
+
+    RT_Reporting = false;
+}
+
+void MakoRTCheck::Summary()
+{
+    Mako_RT_Print("MakoRTCheck: %d violations from %d call sites.\n", Violations(), Sites());
+    for (auto& Site : RT_Sites)
+        if (Site.Hash.load() != 0) Mako_RT_Print("  %8d  %s  (site %016llx)\n", Site.Count.load(), Site.What, (unsigned long long) Site.Hash.load());
+}
+
+//********************************************************************************
+//R1.02 Wrappers. glibc exports its allocator as __libc_*, so those need no lookup.
+//R1.02 Everything else is found with dlsym once, before main runs.
+//********************************************************************************
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void __libc_free(void*);
+}
+
+template <typename F>
+static F Mako_RT_Real(F& Ptr, const char* Name)
+{
+    if (Ptr == nullptr) Ptr = reinterpret_cast<F>(dlsym(RTLD_NEXT, Name));
+    return Ptr;
+}
+
+static int (*Real_MutexLock)(pthread_mutex_t*) = nullptr;
+static int (*Real_RwRd)(pthread_rwlock_t*) = nullptr;
+static int (*Real_RwWr)(pthread_rwlock_t*) = nullptr;
+static int (*Real_CondWait)(pthread_cond_t*, pthread_mutex_t*) = nullptr;
+static int (*Real_CondTimed)(pthread_cond_t*, pthread_mutex_t*, const timespec*) = nullptr;
+static int (*Real_SemWait)(sem_t*) = nullptr;
+static int (*Real_Join)(pthread_t, void**) = nullptr;
+static int (*Real_Nanosleep)(const timespec*, timespec*) = nullptr;
+static int (*Real_Usleep)(useconds_t) = nullptr;
+static int (*Real_Poll)(pollfd*, nfds_t, int) = nullptr;
+static int (*Real_Select)(int, fd_set*, fd_set*, fd_set*, timeval*) = nullptr;
+static ssize_t (*Real_Read)(int, void*, size_t) = nullptr;
+static ssize_t (*Real_Write)(int, const void*, size_t) = nullptr;
+static int (*Real_Open)(const char*, int, ...) = nullptr;
+static FILE* (*Real_Fopen)(const char*, const char*) = nullptr;
+
+//R1.02 Look everything up early so dlsym is never called from inside a wrapper on the audio thread.
+//R1.02 backtrace loads libgcc the first time, so do that now too.
+__attribute__((constructor)) static void Mako_RT_Init()
+{
+    Mako_RT_Real(Real_MutexLock, "pthread_mutex_lock");
+    Mako_RT_Real(Real_RwRd, "pthread_rwlock_rdlock");
+    Mako_RT_Real(Real_RwWr, "pthread_rwlock_wrlock");
+    Real_CondWait = reinterpret_cast<decltype(Real_CondWait)>(dlvsym(RTLD_NEXT, "pthread_cond_wait", "GLIBC_2.3.2"));
+    Real_CondTimed = reinterpret_cast<decltype(Real_CondTimed)>(dlvsym(RTLD_NEXT, "pthread_cond_timedwait", "GLIBC_2.3.2"));
+    Mako_RT_Real(Real_CondWait, "pthread_cond_wait");
+    Mako_RT_Real(Real_CondTimed, "pthread_cond_timedwait");
+    Mako_RT_Real(Real_SemWait, "sem_wait");
+    Mako_RT_Real(Real_Join, "pthread_join");
+    Mako_RT_Real(Real_Nanosleep, "nanosleep");
+    Mako_RT_Real(Real_Usleep, "usleep");
+    Mako_RT_Real(Real_Poll, "poll");
+    Mako_RT_Real(Real_Select, "select");
+    Mako_RT_Real(Real_Read, "read");
+    Mako_RT_Real(Real_Write, "write");
+    Mako_RT_Real(Real_Open, "open");
+    Mako_RT_Real(Real_Fopen, "fopen");
+
+    void* Frames[4];
+    backtrace(Frames, 4);
+}
+
+extern "C" {
+
+void* malloc(size_t n)                  { Mako_RT_Violation("malloc"); return __libc_malloc(n); }
+void* calloc(size_t c, size_t n)        { Mako_RT_Violation("calloc"); return __libc_calloc(c, n); }
+void* realloc(void* p, size_t n)        { Mako_RT_Violation("realloc"); return __libc_realloc(p, n); }
+void free(void* p)                      { if (p != nullptr) Mako_RT_Violation("free"); __libc_free(p); }
+void* memalign(size_t a, size_t n)      { Mako_RT_Violation("memalign"); return __libc_memalign(a, n); }
+void* aligned_alloc(size_t a, size_t n) { Mako_RT_Violation("aligned_alloc"); return __libc_memalign(a, n); }
+
+int posix_memalign(void** p, size_t a, size_t n)
+{
+    Mako_RT_Violation("posix_memalign");
+    *p = __libc_memalign(a, n);
+    return (*p == nullptr) ? ENOMEM : 0;
+}
+
+int pthread_mutex_lock(pthread_mutex_t* m)                  { Mako_RT_Violation("pthread_mutex_lock"); return Mako_RT_Real(Real_MutexLock, "pthread_mutex_lock")(m); }
+int pthread_rwlock_rdlock(pthread_rwlock_t* l)              { Mako_RT_Violation("pthread_rwlock_rdlock"); return Mako_RT_Real(Real_RwRd, "pthread_rwlock_rdlock")(l); }
+int pthread_rwlock_wrlock(pthread_rwlock_t* l)              { Mako_RT_Violation("pthread_rwlock_wrlock"); return Mako_RT_Real(Real_RwWr, "pthread_rwlock_wrlock")(l); }
+int pthread_cond_wait(pthread_cond_t* c, pthread_mutex_t* m) { Mako_RT_Violation("pthread_cond_wait"); return Mako_RT_Real(Real_CondWait, "pthread_cond_wait")(c, m); }
+int pthread_cond_timedwait(pthread_cond_t* c, pthread_mutex_t* m, const timespec* t) { Mako_RT_Violation("pthread_cond_timedwait"); return Mako_RT_Real(Real_CondTimed, "pthread_cond_timedwait")(c, m, t); }
+int sem_wait(sem_t* s)                                      { Mako_RT_Violation("sem_wait"); return Mako_RT_Real(Real_SemWait, "sem_wait")(s); }
+int pthread_join(pthread_t t, void** r)                     { Mako_RT_Violation("pthread_join"); return Mako_RT_Real(Real_Join, "pthread_join")(t, r); }
+int nanosleep(const timespec* t, timespec* r)               { Mako_RT_Violation("nanosleep"); return Mako_RT_Real(Real_Nanosleep, "nanosleep")(t, r); }
+int usleep(useconds_t u)                                    { Mako_RT_Violation("usleep"); return Mako_RT_Real(Real_Usleep, "usleep")(u); }
+int poll(pollfd* f, nfds_t n, int t)                        { Mako_RT_Violation("poll"); return Mako_RT_Real(Real_Poll, "poll")(f, n, t); }
+int select(int n, fd_set* r, fd_set* w, fd_set* e, timeval* t) { Mako_RT_Violation("select"); return Mako_RT_Real(Real_Select, "select")(n, r, w, e, t); }
+ssize_t read(int fd, void* b, size_t n)                     { Mako_RT_Violation("read"); return Mako_RT_Real(Real_Read, "read")(fd, b, n); }
+ssize_t write(int fd, const void* b, size_t n)              { Mako_RT_Violation("write"); return Mako_RT_Real(Real_Write, "write")(fd, b, n); }
+FILE* fopen(const char* p, const char* m)                   { Mako_RT_Violation("fopen"); return Mako_RT_Real(Real_Fopen, "fopen")(p, m); }
+
+int open(const char* p, int f, ...)
+{
+    Mako_RT_Violation("open");
+    mode_t Mode = 0;
+    if ((f & O_CREAT) != 0)
+    {
+        va_list Args;
+        va_start(Args, f);
+        Mode = mode_t(va_arg(Args, int));
+        va_end(Args);
+    }
+    return Mako_RT_Real(Real_Open, "open")(p, f, Mode);
+}
+
+}
+
+#else
+
+//R1.02 Only Linux has the wrappers. Elsewhere nothing is ever caught.
+void MakoRTCheck::Summary()
+{
+    std::fprintf(stderr, "MakoRTCheck: calls are only checked on Linux.\n");
+}
+
+#endif
+
+#endif
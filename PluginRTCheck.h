@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    Realtime safety checker. Reports allocations, locks and blocking calls
+    made while the audio thread (or a thread doing audio work) is inside
+    processBlock.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//R1.02 Build with MAKO_RTCHECK=1 to check. With 0 the markers are compiled away.
+//R1.02 On Linux the checker replaces malloc, pthread_mutex_lock etc, which only works when
+//R1.02 the processor is built into an executable like the stress tool, not a plugin a host loads.
+#ifndef MAKO_RTCHECK
+ #define MAKO_RTCHECK 0
+#endif
+
+#if MAKO_RTCHECK
+
+class MakoRTCheck
+{
+public:
+    static void Arm(bool On);               //R1.02 Nothing is checked until armed.
+    static void Enter();
+    static void Leave();
+
+    static int Violations();                //R1.02 Every bad call so far.
+    static int Sites();                     //R1.02 Different call stacks they came from.
+    static void Summary();                  //R1.02 Print each site and its count to stderr.
+};
+
+struct MakoRTScope {
+    MakoRTScope() { MakoRTCheck::Enter(); }
+    ~MakoRTScope() { MakoRTCheck::Leave(); }
+};
+
+ #define MAKO_RT_SCOPE() MakoRTScope Mako_RT_Scope
+
+#else
+
+ #define MAKO_RT_SCOPE()
+
+#endif
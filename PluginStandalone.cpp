@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    Standalone app for using Mako Rusty as a live amp on Linux with JACK or ALSA.
+
+    Build the Standalone format with JUCE_USE_CUSTOM_PLUGIN_STANDALONE_APP=1 (and
+    JUCE_JACK=1, JUCE_ALSA=1) in the preprocessor definitions. Without it JUCE's
+    normal standalone app is used and this file builds nothing.
+
+    Command line:
+      MakoRusty [--jack | --alsa] [--buffer 32] [--rate 48000]
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#if JucePlugin_Build_Standalone && JUCE_USE_CUSTOM_PLUGIN_STANDALONE_APP
+
+#include <juce_audio_plugin_client/Standalone/juce_StandaloneFilterWindow.h>
+#include <iostream>
+
+#if JUCE_LINUX || JUCE_BSD
+ #include <pthread.h>
+ #include <sched.h>
+ #include <sys/mman.h>
+ #include <sys/resource.h>
+#endif
+
+//R1.02 Rides along with the processor on the device. Does no audio. Makes the audio thread
+//R1.02 realtime on its first callback and watches for late callbacks.
+class MakoRigMonitor : public juce::AudioIODeviceCallback
+{
+public:
+    void audioDeviceAboutToStart(juce::AudioIODevice* Device) override
+    {
+        Period_Ticks = juce::int64(double(juce::Time::getHighResolutionTicksPerSecond()) * Device->getCurrentBufferSizeSamples() / Device->getCurrentSampleRate());
+        Last_Ticks = 0;
+        RT_Checked = false;
+    }
+
+    void audioDeviceStopped() override {}
+
+    void audioDeviceIOCallbackWithContext(const float* const*, int, float* const* Out, int numOut, int numSamples,
+                                          const juce::AudioIODeviceCallbackContext&) override
+    {
+        if (! RT_Checked) Mako_RT_Request();
+
+        //R1.02 A callback more than 1.5 periods after the last one means the card ran dry.
+        auto Now = juce::Time::getHighResolutionTicks();
+        if ((0 < Last_Ticks) && ((Period_Ticks * 3) / 2 < Now - Last_Ticks)) Late.fetch_add(1, std::memory_order_relaxed);
+        Last_Ticks = Now;
+
+        for (int ch = 0; ch < numOut; ch++) juce::FloatVectorOperations::clear(Out[ch], numSamples);
+    }
+
+    std::atomic<int> Late { 0 };
+    std::atomic<bool> RT_On { false };      //R1.02 Audio thread is SCHED_FIFO or SCHED_RR.
+    std::atomic<int> RT_Priority { 0 };
+
+private:
+    //R1.02 JACK already gives its thread realtime priority when jackd runs with -R. ALSA does not, so ask for it.
+    //R1.02 Needs rtprio in /etc/security/limits.conf (or the audio group).
+    void Mako_RT_Request()
+    {
+        RT_Checked = true;
+       #if JUCE_LINUX || JUCE_BSD
+        int Policy = 0;
+        sched_param Parm {};
+        pthread_getschedparam(pthread_self(), &Policy, &Parm);
+        if ((Policy != SCHED_FIFO) && (Policy != SCHED_RR))
+        {
+            sched_param Want {};
+            Want.sched_priority = juce::jmax(1, sched_get_priority_max(SCHED_FIFO) - 10);
+            if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &Want) == 0)
+            {
+                Policy = SCHED_FIFO;
+                Parm = Want;
+            }
+        }
+        RT_Priority.store(Parm.sched_priority);
+        RT_On.store((Policy == SCHED_FIFO) || (Policy == SCHED_RR));
+       #endif
+    }
+
+    juce::int64 Period_Ticks = 0;
+    juce::int64 Last_Ticks = 0;
+    bool RT_Checked = false;
+};
+
+//********************************************************************************
+//R1.02 The same window as JUCE's standalone, opened on JACK or ALSA at a small buffer.
+//R1.02 The title shows the device, latency, realtime state and xruns. Changes are also printed.
+//********************************************************************************
+class MakoStandaloneApp : public juce::JUCEApplication , private juce::Timer
+{
+public:
+    MakoStandaloneApp()
+    {
+        juce::PluginHostType::jucePlugInClientCurrentWrapperType = juce::AudioProcessor::wrapperType_Standalone;
+
+        juce::PropertiesFile::Options Opt;
+        Opt.applicationName = JucePlugin_Name;
+        Opt.filenameSuffix = ".settings";
+        Opt.osxLibrarySubFolder = "Application Support";
+        Opt.folderName = "~/.config";
+        Settings.setStorageParameters(Opt);
+    }
+
+    const juce::String getApplicationName() override { return JucePlugin_Name; }
+    const juce::String getApplicationVersion() override { return JucePlugin_VersionString; }
+    bool moreThanOneInstanceAllowed() override { return true; }
+    void anotherInstanceStarted(const juce::String&) override {}
+
+    void initialise(const juce::String& commandLine) override
+    {
+        juce::StringArray Args;
+        Args.addTokens(commandLine, true);
+        auto Opt = [&](const char* Name, int Default) { int i = Args.indexOf(Name); return ((0 <= i) && (i + 1 < Args.size())) ? Args[i + 1].getIntValue() : Default; };
+        int Buffer = juce::jlimit(16, 1024, Opt("--buffer", 32));
+        int Rate = juce::jlimit(22050, 192000, Opt("--rate", 48000));
+        juce::String Type = Args.contains("--alsa") ? "ALSA" : "JACK";
+
+        Window.reset(new juce::StandaloneFilterWindow(getApplicationName(), juce::Colours::black, Settings.getUserSettings(), false));
+        auto& Devices = Window->getPluginHolder()->deviceManager;
+
+        //R1.02 JACK when it is running, else ALSA.
+        Devices.setCurrentAudioDeviceType(Type, true);
+        if ((Devices.getCurrentAudioDevice() == nullptr) && (Type == "JACK")) Devices.setCurrentAudioDeviceType("ALSA", true);
+
+        //R1.02 JACK sets its own buffer and rate, so this only changes ALSA.
+        auto Setup = Devices.getAudioDeviceSetup();
+        Setup.bufferSize = Buffer;
+        Setup.sampleRate = Rate;
+        juce::String Err = Devices.setAudioDeviceSetup(Setup, true);
+        if (Err.isNotEmpty()) std::cout << "Audio device: " << Err << std::endl;
+
+        Devices.addAudioCallback(&Monitor);
+        Window->setVisible(true);
+
+        //R1.02 After everything is loaded, so the processor and device buffers are in RAM.
+        Mako_Memory_Lock();
+        startTimer(500);
+    }
+
+    void shutdown() override
+    {
+        stopTimer();
+        if (Window != nullptr) Window->getPluginHolder()->deviceManager.removeAudioCallback(&Monitor);
+        Window = nullptr;
+    }
+
+    void systemRequestedQuit() override
+    {
+        if (Window != nullptr) Window->getPluginHolder()->savePluginState();
+        quit();
+    }
+
+private:
+    //R1.02 Keep every page in RAM. Only lock future allocations too when the limit can not run out,
+    //R1.02 otherwise a later allocation would fail instead of paging.
+    void Mako_Memory_Lock()
+    {
+       #if JUCE_LINUX || JUCE_BSD
+        rlimit Lim {};
+        bool Unlimited = (getrlimit(RLIMIT_MEMLOCK, &Lim) == 0) && (Lim.rlim_cur == RLIM_INFINITY);
+        Mem_Unlocked = (mlockall(Unlimited ? (MCL_CURRENT | MCL_FUTURE) : MCL_CURRENT) != 0);
+        if (Mem_Unlocked) std::cout << "Could not lock memory. Raise memlock in /etc/security/limits.conf." << std::endl;
+       #endif
+    }
+
+    //R1.02 Round trip is what the device reports plus our own latency. When the device reports
+    //R1.02 nothing we count one input and one output buffer.
+    void timerCallback() override
+    {
+        auto* Holder = Window->getPluginHolder();
+        auto* Device = Holder->deviceManager.getCurrentAudioDevice();
+        if (Device == nullptr)
+        {
+            Window->setName(getApplicationName() + " - No audio device");
+            return;
+        }
+
+        int Buffer = Device->getCurrentBufferSizeSamples();
+        double Rate = Device->getCurrentSampleRate();
+        int Trip = juce::jmax(Device->getInputLatencyInSamples() + Device->getOutputLatencyInSamples(), 2 * Buffer);
+        Trip += Holder->processor->getLatencySamples();
+
+        int XRuns = juce::jmax(0, Device->getXRunCount()) + Monitor.Late.load();
+        bool RT = Monitor.RT_On.load();
+
+        juce::String Status = Device->getTypeName() + " " + juce::String(Rate / 1000.0, 1) + "k/" + juce::String(Buffer)
+                            + " - " + juce::String(1000.0 * Trip / Rate, 1) + "mS round trip"
+                            + (RT ? " - RT " + juce::String(Monitor.RT_Priority.load()) : " - not RT")
+                            + (Mem_Unlocked ? " - not locked" : "")
+                            + " - xruns " + juce::String(XRuns);
+        Window->setName(getApplicationName() + " - " + Status);
+
+        if (Status != Status_Last) std::cout << Status << std::endl;
+        Status_Last = Status;
+    }
+
+    juce::ApplicationProperties Settings;
+    std::unique_ptr<juce::StandaloneFilterWindow> Window;
+    MakoRigMonitor Monitor;
+    bool Mem_Unlocked = false;
+    juce::String Status_Last;
+};
+
+juce::JUCEApplicationBase* juce_CreateApplication()
+{
+    return new MakoStandaloneApp();
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    Timeline tracing for chasing dropouts. Exports Chrome trace-event JSON,
+    which chrome://tracing and ui.perfetto.dev can open.
+
+  ==============================================================================
+*/
+
+#include "PluginTrace.h"
+
+#if MAKO_TRACE
+
+//R1.02 Only the owning thread writes a ring. Head counts every event ever written and is
+//R1.02 published after the event, so Export knows which events are complete.
+//R1.02 A ring keeps its events when its thread exits, the next thread to take it adds to them.
+struct tp_tracering {
+    std::atomic<juce::int64> Head { 0 };
+    std::atomic<const char*> Name { nullptr };
+    std::atomic<bool> Owned { false };
+    MakoTraceEvent Events[MakoTrace::Event_Max];
+};
+
+static tp_tracering Trace_Rings[MakoTrace::Thread_Max];
+static std::atomic<int> Trace_Used { 0 };       //R1.02 Rings ever taken. Export reads this many.
+static std::atomic<int> Trace_Dropped { 0 };
+
+//R1.02 Gives the ring back when its thread exits. Workers are recreated, so rings must not run out.
+struct tp_traceowner {
+    tp_tracering* Ring = nullptr;
+    bool NoRoom = false;
+    ~tp_traceowner() { if (Ring != nullptr) Ring->Owned.store(false, std::memory_order_release); }
+};
+static thread_local tp_traceowner Trace_Mine;
+
+//R1.02 First use on a thread claims the first free ring.
+static tp_tracering* Mako_Trace_Ring()
+{
+    if ((Trace_Mine.Ring == nullptr) && ! Trace_Mine.NoRoom)
+    {
+        for (int r = 0; r < MakoTrace::Thread_Max; r++)
+        {
+            bool Free = false;
+            if (! Trace_Rings[r].Owned.compare_exchange_strong(Free, true, std::memory_order_acq_rel)) continue;
+
+            Trace_Rings[r].Name.store(nullptr, std::memory_order_relaxed);
+            Trace_Mine.Ring = &Trace_Rings[r];
+            int Used = Trace_Used.load();
+            while ((Used < r + 1) && ! Trace_Used.compare_exchange_weak(Used, r + 1)) {}
+            return Trace_Mine.Ring;
+        }
+
+        Trace_Mine.NoRoom = true;
+        Trace_Dropped.fetch_add(1);
+    }
+    return Trace_Mine.Ring;
+}
+
+void MakoTrace::Add(const char* Name, juce::int64 Start, juce::int64 End)
+{
+    tp_tracering* R = Mako_Trace_Ring();
+    if (R == nullptr) return;
+
+    juce::int64 H = R->Head.load(std::memory_order_relaxed);
+    R->Events[H & (Event_Max - 1)] = { Name, Start, End };
+    R->Head.store(H + 1, std::memory_order_release);
+}
+
+void MakoTrace::Thread_Name(const char* Name)
+{
+    tp_tracering* R = Mako_Trace_Ring();
+    if (R != nullptr) R->Name.store(Name, std::memory_order_relaxed);
+}
+
+int MakoTrace::Dropped()
+{
+    return Trace_Dropped.load();
+}
+
+bool MakoTrace::Export(const juce::File& File)
+{
+    struct tp_out { int Tid; MakoTraceEvent E; };
+    std::vector<tp_out> Out;
+    juce::StringArray Names;
+
+    int Used = juce::jmin(Trace_Used.load(), int(Thread_Max));
+    for (int r = 0; r < Used; r++)
+    {
+        tp_tracering& R = Trace_Rings[r];
+        const char* N = R.Name.load();
+        Names.add((N != nullptr) ? juce::String(N) : "Thread " + juce::String(r));
+
+        //R1.02 Copy, then drop anything the owner may have overwritten while we were copying.
+        juce::int64 H1 = R.Head.load(std::memory_order_acquire);
+        juce::int64 First = juce::jmax(juce::int64(0), H1 - Event_Max);
+        size_t Base = Out.size();
+        for (juce::int64 e = First; e < H1; e++) Out.push_back({ r, R.Events[e & (Event_Max - 1)] });
+
+        juce::int64 H2 = R.Head.load(std::memory_order_acquire);
+        juce::int64 Safe = juce::jmax(juce::int64(0), H2 - Event_Max + 1) - First;
+        if (0 < Safe) Out.erase(Out.begin() + juce::int64(Base), Out.begin() + juce::int64(Base) + juce::jmin(Safe, H1 - First));
+    }
+
+    juce::int64 T0 = std::numeric_limits<juce::int64>::max();
+    for (auto& O : Out) T0 = juce::jmin(T0, O.E.Start);
+    double uS = 1.0e6 / double(juce::Time::getHighResolutionTicksPerSecond());
+
+    //R1.02 Complete (X) events in microseconds, plus a name for each thread.
+    juce::MemoryOutputStream J;
+    J << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    J << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"" << JucePlugin_Name << "\"}}";
+
+    //R1.02 Say so when threads were not recorded, so a missing thread is not mistaken for an idle one.
+    if (0 < Dropped())
+        J << ",\n{\"name\":\"process_labels\",\"ph\":\"M\",\"pid\":1,\"args\":{\"labels\":\"" << Dropped() << " threads not recorded\"}}";
+    for (int r = 0; r < Used; r++)
+        J << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << r << ",\"args\":{\"name\":" << juce::JSON::toString(Names[r]) << "}}";
+    for (auto& O : Out)
+    {
+        J << ",\n{\"name\":" << juce::JSON::toString(juce::String(O.E.Name)) << ",\"cat\":\"mako\",\"ph\":\"X\",\"pid\":1,\"tid\":" << O.Tid
+          << ",\"ts\":" << juce::String(double(O.E.Start - T0) * uS, 3) << ",\"dur\":" << juce::String(double(O.E.End - O.E.Start) * uS, 3) << "}";
+    }
+    J << "\n]}\n";
+
+    return File.replaceWithData(J.getData(), J.getDataSize());
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    Timeline tracing for chasing dropouts. Exports Chrome trace-event JSON,
+    which chrome://tracing and ui.perfetto.dev can open.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//R1.02 Build with MAKO_TRACE=1 to record every marker. With 0 the markers are compiled away.
+#ifndef MAKO_TRACE
+ #define MAKO_TRACE 0
+#endif
+
+#if MAKO_TRACE
+
+//R1.02 One finished marker. Name must be a string literal, only the pointer is kept.
+struct MakoTraceEvent {
+    const char* Name;
+    juce::int64 Start;              //R1.02 Time::getHighResolutionTicks().
+    juce::int64 End;
+};
+
+//R1.02 Every thread that records gets its own ring of events, so recording never locks
+//R1.02 or allocates. When a ring fills up the oldest events are overwritten.
+class MakoTrace
+{
+public:
+    static const int Thread_Max = 32;       //R1.02 Threads running at once. Rings are reused when threads exit.
+    static const int Event_Max = 65536;     //R1.02 Per thread. Must be a power of 2.
+
+    static void Add(const char* Name, juce::int64 Start, juce::int64 End);
+    static void Thread_Name(const char* Name);
+
+    //R1.02 Threads that found every ring taken and recorded nothing.
+    static int Dropped();
+
+    //R1.02 Not realtime. Can run while other threads are still recording.
+    static bool Export(const juce::File& File);
+};
+
+//R1.02 Records from construction to the end of the scope.
+class MakoTraceScope
+{
+public:
+    explicit MakoTraceScope(const char* n) : Name(n), Start(juce::Time::getHighResolutionTicks()) {}
+    ~MakoTraceScope() { MakoTrace::Add(Name, Start, juce::Time::getHighResolutionTicks()); }
+
+private:
+    const char* Name;
+    juce::int64 Start;
+};
+
+ #define MAKO_TRACE_JOIN2(a, b) a##b
+ #define MAKO_TRACE_JOIN(a, b) MAKO_TRACE_JOIN2(a, b)
+ #define MAKO_TRACE_SCOPE(Name) MakoTraceScope MAKO_TRACE_JOIN(Mako_Trace_, __LINE__) (Name)
+ #define MAKO_TRACE_THREAD(Name) MakoTrace::Thread_Name(Name)
+
+#else
+
+ #define MAKO_TRACE_SCOPE(Name)
+ #define MAKO_TRACE_THREAD(Name)
+
+#endif
@@ -0,0 +1,335 @@
+/*
+  ==============================================================================
+
+    MakoRustyStress - Find the worst blocks, not the average ones.
+
+    Runs processBlock at realistic block sizes while another thread automates every
+    parameter, flips IR models and EQ modes, changes presets and restores saved states.
+    The audio thread also gets a MIDI program change now and then.
+    Every block is timed and the whole distribution is reported.
+
+    Build as a JUCE Console Application that also compiles PluginProcessor.cpp,
+    PluginEditor.cpp, PluginIRs.cpp, PluginPool.cpp, PluginTrace.cpp, PluginRTCheck.cpp,
+    and the BinaryData images. Add JucePlugin_Name="MakoRusty" to the preprocessor definitions.
+    Add MAKO_RTCHECK=1 too for --rtcheck.
+
+    Usage:
+      MakoRustyStress [--rate 48000] [--blocks 32,64,128,256] [--seconds 20] [--deadline .5]
+                      [--misses 0] [--automate 200] [--states 4] [--fast] [--csv times.csv] [--rtcheck]
+                      [--tiers]
+
+    --deadline is the fraction of each block's period a block may use. The run fails when
+    more than --misses blocks go over it. --fast does not wait for the next block's time,
+    which is quicker but the automation then lands on fewer blocks. --rtcheck also fails the run
+    if processBlock allocates, locks or blocks (Linux, MAKO_RTCHECK=1 builds only).
+    --tiers also checks that stepping the governor through its IR tiers and toggling Eco Cab
+    sounds the same with Cab Pool on as off, so no stale pool tail is ever mixed in.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "../PluginRTCheck.h"
+#include <thread>
+#include <iostream>
+#include <algorithm>
+
+//R1.02 Results for one block size.
+struct t_StressResult {
+    int Block = 0;
+    double Construct_mS = 0.0;
+    double Prepare_mS = 0.0;
+    double Period_uS = 0.0;
+    std::vector<double> Times_uS;
+    int Misses = 0;
+    juce::int64 Automations = 0;
+    juce::int64 Restores = 0;
+};
+
+//R1.02 Something guitar like. Plucks that ring and die away with quiet gaps between them,
+//R1.02 so the gate opens and closes too.
+static void Mako_Stress_Input(juce::AudioBuffer<float>& Buffer, double Rate, juce::int64 Pos, juce::Random& Rnd)
+{
+    float* L = Buffer.getWritePointer(0);
+    float* R = Buffer.getWritePointer(1);
+    for (int t = 0; t < Buffer.getNumSamples(); t++)
+    {
+        double Sec = double(Pos + t) / Rate;
+        double Note = std::fmod(Sec, .75);
+        double Env = (Note < .6) ? std::exp(-Note * 6.0) : 0.0;
+        double Hz = 82.41 * std::pow(2.0, double(int(Sec / .75) % 24) / 12.0);
+        float V = float(Env * .6 * (std::sin(2.0 * juce::MathConstants<double>::pi * Hz * Sec) + .3 * std::sin(6.0 * juce::MathConstants<double>::pi * Hz * Sec)));
+        L[t] = V + (Rnd.nextFloat() - .5f) * .001f;
+        R[t] = L[t];
+    }
+}
+
+//R1.02 Automation thread. Acts like a host: moves parameters, changes presets and restores states.
+static void Mako_Stress_Automate(MakoBiteAudioProcessor& Proc, std::atomic<bool>& Stop, int PerSecond, int StatesPerSecond,
+                                 const std::vector<juce::MemoryBlock>& States, t_StressResult& Result)
+{
+    juce::Random Rnd(1234);
+    juce::RangedAudioParameter* Parms[MakoBiteAudioProcessor::Parm_Cnt];
+    for (int t = 0; t < MakoBiteAudioProcessor::Parm_Cnt; t++) Parms[t] = Proc.parameters.getParameter(MakoBiteAudioProcessor::Parm_IDs[t]);
+    auto* IR = Proc.parameters.getParameter("ir");
+    auto* EQ = Proc.parameters.getParameter("eq");
+
+    double Next_State = juce::Time::getMillisecondCounterHiRes();
+    double Next_Follow = Next_State;
+    int Sleep_mS = juce::jmax(1, 1000 / juce::jmax(1, PerSecond));
+    while (! Stop.load())
+    {
+        //R1.02 One random parameter, plus the expensive ones every time.
+        auto* P = Parms[Rnd.nextInt(MakoBiteAudioProcessor::Parm_Cnt)];
+        P->setValueNotifyingHost(Rnd.nextFloat());
+        IR->setValueNotifyingHost(Rnd.nextFloat());
+        EQ->setValueNotifyingHost(Rnd.nextFloat());
+        Proc.Mako_Settings_FromParameters();
+        if (Rnd.nextInt(50) == 0) Proc.setCurrentProgram(Rnd.nextInt(Proc.getNumPrograms()));
+        Result.Automations++;
+
+        double Now = juce::Time::getMillisecondCounterHiRes();
+        if ((0 < StatesPerSecond) && (Next_State <= Now))
+        {
+            auto& S = States[size_t(Rnd.nextInt(int(States.size())))];
+            Proc.setStateInformation(S.getData(), int(S.getSize()));
+            Result.Restores++;
+            Next_State = Now + 1000.0 / StatesPerSecond;
+        }
+
+        //R1.02 This thread is the host's message thread too. Run what the plugin's 20 Hz timer would,
+        //R1.02 so the preset follow's host notifications race processBlock like they do in a DAW.
+        if (Next_Follow <= Now)
+        {
+            Proc.Mako_Preset_Follow();
+            Proc.Mako_Threads_Follow();
+            Proc.Mako_Profile_Follow();
+            Next_Follow = Now + 50.0;
+        }
+
+        juce::Thread::sleep(Sleep_mS);
+    }
+}
+
+//R1.02 Run one block size. Construction and prepareToPlay are timed too since hosts do them on busy threads.
+static void Mako_Stress_Run(t_StressResult& Result, double Rate, int Block, double Seconds, bool Fast, int PerSecond, int StatesPerSecond, bool RTCheck)
+{
+    Result.Block = Block;
+    Result.Period_uS = 1.0e6 * Block / Rate;
+
+    auto T0 = juce::Time::getHighResolutionTicks();
+    MakoBiteAudioProcessor Proc;
+    auto T1 = juce::Time::getHighResolutionTicks();
+    Proc.setPlayConfigDetails(2, 2, Rate, Block);
+    Proc.prepareToPlay(Rate, Block);
+    auto T2 = juce::Time::getHighResolutionTicks();
+    Result.Construct_mS = 1000.0 * juce::Time::highResolutionTicksToSeconds(T1 - T0);
+    Result.Prepare_mS = 1000.0 * juce::Time::highResolutionTicksToSeconds(T2 - T1);
+
+    //R1.02 The eco fit waits for Eco Cab to be turned on. Do it now so prepare shows the whole setup cost.
+    auto* Eco = Proc.parameters.getParameter("eco");
+    float Eco_Was = Eco->getValue();
+    Eco->setValueNotifyingHost(1.0f);
+    Proc.Mako_Threads_Follow();
+    Eco->setValueNotifyingHost(Eco_Was);
+    Result.Prepare_mS += Proc.Eco_Fit_mS;
+
+    //R1.02 A few saved states to restore. Random settings, so each restore really changes things.
+    std::vector<juce::MemoryBlock> States(8);
+    {
+        MakoBiteAudioProcessor Maker;
+        juce::Random Rnd(99);
+        for (auto& S : States)
+        {
+            for (int t = 0; t < MakoBiteAudioProcessor::Parm_Cnt; t++)
+                Maker.parameters.getParameter(MakoBiteAudioProcessor::Parm_IDs[t])->setValueNotifyingHost(Rnd.nextFloat());
+            Maker.getStateInformation(S);
+        }
+    }
+
+    juce::int64 Blocks = juce::jmax(juce::int64(1), juce::int64(Seconds * Rate / Block));
+    Result.Times_uS.assign(size_t(Blocks), 0.0);
+
+    juce::AudioBuffer<float> Buffer(2, Block);
+    juce::MidiBuffer Midi;
+    Midi.ensureSize(256);       //R1.02 So adding a program change never allocates.
+    juce::Random Rnd(7);
+
+    std::atomic<bool> Stop { false };
+    std::thread Automation([&]() { Mako_Stress_Automate(Proc, Stop, PerSecond, StatesPerSecond, States, Result); });
+
+    double Ticks_uS = 1.0e6 / double(juce::Time::getHighResolutionTicksPerSecond());
+    double Start_mS = juce::Time::getMillisecondCounterHiRes();
+   #if MAKO_RTCHECK
+    MakoRTCheck::Arm(RTCheck);
+   #else
+    juce::ignoreUnused(RTCheck);
+   #endif
+    for (juce::int64 b = 0; b < Blocks; b++)
+    {
+        //R1.02 Wait for this block's time like a sound card would.
+        if (! Fast)
+        {
+            double Due = Start_mS + (b * Result.Period_uS) / 1000.0;
+            while (juce::Time::getMillisecondCounterHiRes() < Due) juce::Thread::sleep(0);
+        }
+
+        Mako_Stress_Input(Buffer, Rate, b * Block, Rnd);
+
+        //R1.02 A foot controller picking presets over MIDI.
+        Midi.clear();
+        if (Rnd.nextInt(400) == 0) Midi.addEvent(juce::MidiMessage::programChange(1, Rnd.nextInt(Proc.getNumPrograms())), 0);
+
+        auto B0 = juce::Time::getHighResolutionTicks();
+        Proc.processBlock(Buffer, Midi);
+        auto B1 = juce::Time::getHighResolutionTicks();
+
+        Result.Times_uS[size_t(b)] = double(B1 - B0) * Ticks_uS;
+    }
+
+   #if MAKO_RTCHECK
+    MakoRTCheck::Arm(false);
+   #endif
+    Stop.store(true);
+    Automation.join();
+}
+
+//R1.02 Two processors get the same input and the same governor tiers and eco changes, one with
+//R1.02 Cab Pool on. The pool only moves work between threads, so they must match to rounding.
+static bool Mako_Stress_Tiers(double Rate, int Block, bool Fast)
+{
+    MakoBiteAudioProcessor Procs[2];
+    for (int p = 0; p < 2; p++)
+    {
+        Procs[p].parameters.getParameter("cabpool")->setValueNotifyingHost(float(p));
+        Procs[p].setPlayConfigDetails(2, 2, Rate, Block);
+        Procs[p].prepareToPlay(Rate, Block);
+    }
+
+    juce::AudioBuffer<float> Buffers[2] = { juce::AudioBuffer<float>(2, Block), juce::AudioBuffer<float>(2, Block) };
+    juce::MidiBuffer Midi;
+    juce::Random Rnd(11);
+    static const int Tiers[8] = { 0, 1, 2, 3, 4, 3, 2, 1 };
+    juce::int64 Blocks = juce::int64(6.0 * Rate / Block);
+    double Period_mS = 1000.0 * Block / Rate;
+    double Start_mS = juce::Time::getMillisecondCounterHiRes();
+    float Worst = 0.0f;
+
+    for (juce::int64 b = 0; b < Blocks; b++)
+    {
+        //R1.02 Real time pacing, so the pool has its block to finish the tails and they are really used.
+        if (! Fast) while (juce::Time::getMillisecondCounterHiRes() < Start_mS + b * Period_mS) juce::Thread::sleep(0);
+
+        double Sec = double(b * Block) / Rate;
+        Mako_Stress_Input(Buffers[0], Rate, b * Block, Rnd);
+        Buffers[1].makeCopyOf(Buffers[0], true);
+        for (int p = 0; p < 2; p++)
+        {
+            Procs[p].Mako_Gov_Force(Tiers[int(Sec / .25) % 8]);
+            Procs[p].parameters.getParameter("eco")->setValueNotifyingHost((int(Sec / .7) % 3 == 2) ? 1.0f : 0.0f);
+            Procs[p].Mako_Threads_Follow();
+            Procs[p].processBlock(Buffers[p], Midi);
+        }
+
+        for (int c = 0; c < 2; c++)
+            for (int t = 0; t < Block; t++) Worst = juce::jmax(Worst, std::abs(Buffers[0].getSample(c, t) - Buffers[1].getSample(c, t)));
+    }
+
+    float Worst_dB = juce::Decibels::gainToDecibels(Worst, -200.0f);
+    bool Ok = (Worst_dB < -80.0f);
+    char Line[256];
+    snprintf(Line, sizeof(Line), "tiers %5d  Cab Pool on vs off differ by %.1f dBFS at most, %d late tails  %s",
+             Block, Worst_dB, Procs[1].Mako_Pool_Misses(), Ok ? "ok" : "FAIL");
+    std::cout << Line << std::endl;
+    return Ok;
+}
+
+static double Mako_Stress_Pct(const std::vector<double>& Sorted, double Pct)
+{
+    size_t Idx = size_t(std::ceil(Pct / 100.0 * Sorted.size()));
+    return Sorted[juce::jlimit(size_t(0), Sorted.size() - 1, (Idx == 0) ? 0 : Idx - 1)];
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList Args(argc, argv);
+    auto Opt = [&](const char* Name, const juce::String& Default) { return Args.containsOption(Name) ? Args.getValueForOption(Name) : Default; };
+
+    double Rate = Opt("--rate", "48000").getDoubleValue();
+    double Seconds = juce::jmax(.1, Opt("--seconds", "20").getDoubleValue());
+    double Deadline = juce::jlimit(.01, 1.0, Opt("--deadline", ".5").getDoubleValue());
+    int Misses_Allowed = juce::jmax(0, Opt("--misses", "0").getIntValue());
+    int PerSecond = juce::jlimit(1, 1000, Opt("--automate", "200").getIntValue());
+    int StatesPerSecond = juce::jlimit(0, 100, Opt("--states", "4").getIntValue());
+    bool Fast = Args.containsOption("--fast");
+    bool RTCheck = Args.containsOption("--rtcheck");
+    bool Tiers = Args.containsOption("--tiers");
+    juce::String Csv = Opt("--csv", "");
+
+    juce::StringArray Sizes;
+    Sizes.addTokens(Opt("--blocks", "32,64,128,256"), ",", "");
+    Sizes.trim();
+    Sizes.removeEmptyStrings();
+
+   #if ! MAKO_RTCHECK
+    if (RTCheck)
+    {
+        std::cout << "--rtcheck needs a build with MAKO_RTCHECK=1." << std::endl;
+        return 1;
+    }
+   #endif
+
+    //R1.02 Message manager for the processor's preset timer.
+    juce::ScopedJuceInitialiser_GUI Juce;
+
+    std::vector<t_StressResult> Results;
+    for (auto& S : Sizes)
+    {
+        int Block = juce::jlimit(8, 8192, S.getIntValue());
+        Results.emplace_back();
+        Mako_Stress_Run(Results.back(), Rate, Block, Seconds, Fast, PerSecond, StatesPerSecond, RTCheck);
+    }
+
+    //R1.02 All times in microseconds. Load is time / block period.
+    bool Failed = false;
+    juce::String CsvText = "block,index,us\n";
+    std::cout << "block  construct_ms prepare_ms  period_us     p50     p99   p99.9     max   max_load  over  automations restores" << std::endl;
+    for (auto& R : Results)
+    {
+        std::vector<double> Sorted = R.Times_uS;
+        std::sort(Sorted.begin(), Sorted.end());
+
+        double Limit = R.Period_uS * Deadline;
+        R.Misses = int(std::count_if(Sorted.begin(), Sorted.end(), [Limit](double t) { return Limit < t; }));
+        if (Misses_Allowed < R.Misses) Failed = true;
+
+        char Line[256];
+        snprintf(Line, sizeof(Line), "%5d  %12.2f %10.2f  %9.1f %7.1f %7.1f %7.1f %7.1f %9.1f%% %5d  %11lld %8lld",
+                 R.Block, R.Construct_mS, R.Prepare_mS, R.Period_uS,
+                 Mako_Stress_Pct(Sorted, 50.0), Mako_Stress_Pct(Sorted, 99.0), Mako_Stress_Pct(Sorted, 99.9), Sorted.back(),
+                 100.0 * Sorted.back() / R.Period_uS, R.Misses, (long long) R.Automations, (long long) R.Restores);
+        std::cout << Line << std::endl;
+
+        if (Csv.isNotEmpty())
+            for (size_t t = 0; t < R.Times_uS.size(); t++) CsvText << R.Block << "," << int(t) << "," << juce::String(R.Times_uS[t], 2) << "\n";
+    }
+
+    if (Csv.isNotEmpty()) juce::File::getCurrentWorkingDirectory().getChildFile(Csv).replaceWithText(CsvText);
+
+    //R1.02 Every stack was printed as it happened. This is the count for each.
+   #if MAKO_RTCHECK
+    if (RTCheck)
+    {
+        MakoRTCheck::Summary();
+        if (0 < MakoRTCheck::Violations()) Failed = true;
+    }
+   #endif
+
+    if (Tiers)
+        for (auto& R : Results)
+            if (! Mako_Stress_Tiers(Rate, R.Block, Fast)) Failed = true;
+
+    std::cout << (Failed ? "FAIL" : "PASS") << ": deadline " << Deadline * 100.0 << "% of each block, " << Misses_Allowed << " misses allowed." << std::endl;
+    return Failed ? 1 : 0;
+}
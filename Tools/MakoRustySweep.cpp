@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+    MakoRustySweep - Render one DI file thru every combination of a parameter grid.
+
+    Build as a JUCE Console Application that also compiles PluginProcessor.cpp,
+    PluginEditor.cpp, PluginIRs.cpp, PluginPool.cpp, PluginTrace.cpp, and the BinaryData images. Add JucePlugin_Name="MakoRusty"
+    to the preprocessor definitions.
+
+    Usage:
+      MakoRustySweep --in guitar.wav --out renders --grid "drive=.1,.5,.9;eq=0,3;ir=1,2,5;bottom=.25,.75"
+                     [--threads 8] [--block 512]
+
+    Writes renders/sweep_0001.wav ... and renders/index.json.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <iostream>
+
+//R1.02 One grid axis. A parameter ID and the values to try.
+struct t_SweepAxis {
+    juce::String ID;
+    std::vector<float> Values;
+};
+
+//R1.02 One render. Holds an index into every axis.
+struct t_SweepJob {
+    std::vector<int> ValueIdx;
+    juce::String FileName;
+    bool Ok = false;
+};
+
+//R1.02 Each worker owns a queue. Workers take from the front of their own queue
+//R1.02 and steal from the back of the other queues when theirs runs dry.
+struct t_SweepQueue {
+    std::mutex Lock;
+    std::deque<int> Jobs;
+};
+
+//R1.02 Parse "drive=.1,.5;ir=1,2" into our axes.
+static bool Mako_Sweep_ParseGrid(const juce::String& Grid, std::vector<t_SweepAxis>& Axes)
+{
+    juce::StringArray Items;
+    Items.addTokens(Grid, ";", "");
+    Items.trim();
+    Items.removeEmptyStrings();
+
+    for (auto& Item : Items)
+    {
+        t_SweepAxis Axis;
+        Axis.ID = Item.upToFirstOccurrenceOf("=", false, false).trim();
+
+        juce::StringArray Vals;
+        Vals.addTokens(Item.fromFirstOccurrenceOf("=", false, false), ",", "");
+        Vals.trim();
+        Vals.removeEmptyStrings();
+        for (auto& V : Vals) Axis.Values.push_back(V.getFloatValue());
+
+        if (Axis.ID.isEmpty() || Axis.Values.empty()) return false;
+        Axes.push_back(Axis);
+    }
+
+    return ! Axes.empty();
+}
+
+//R1.02 Pop our next job. Returns -1 when every queue is empty.
+static int Mako_Sweep_NextJob(std::vector<t_SweepQueue>& Queues, int Worker)
+{
+    {
+        std::lock_guard<std::mutex> Lock(Queues[Worker].Lock);
+        if (! Queues[Worker].Jobs.empty())
+        {
+            int Job = Queues[Worker].Jobs.front();
+            Queues[Worker].Jobs.pop_front();
+            return Job;
+        }
+    }
+
+    //R1.02 Our queue is empty, steal from the back of someone elses.
+    for (size_t t = 1; t < Queues.size(); t++)
+    {
+        auto& Victim = Queues[(Worker + t) % Queues.size()];
+        std::lock_guard<std::mutex> Lock(Victim.Lock);
+        if (! Victim.Jobs.empty())
+        {
+            int Job = Victim.Jobs.back();
+            Victim.Jobs.pop_back();
+            return Job;
+        }
+    }
+
+    return -1;
+}
+
+//R1.02 Render one grid point with a processor that is reused across jobs.
+static bool Mako_Sweep_Render(MakoBiteAudioProcessor& Proc, const juce::AudioBuffer<float>& Input, juce::AudioBuffer<float>& Output,
+                              const std::vector<t_SweepAxis>& Axes, const t_SweepJob& Job, double SampleRate, int BlockSize, const juce::File& OutFile)
+{
+    //R1.02 Set the grid values. Any parameter not in the grid keeps its default.
+    for (size_t a = 0; a < Axes.size(); a++)
+    {
+        auto* Parm = Proc.parameters.getParameter(Axes[a].ID);
+        Parm->setValueNotifyingHost(Parm->convertTo0to1(Axes[a].Values[Job.ValueIdx[a]]));
+    }
+    Proc.Mako_Settings_FromParameters();
+
+    //R1.02 Render like a bounce, so the CPU governor never changes the result with the machine's load.
+    //R1.02 prepareToPlay clears the old render and recalcs the filters and IR.
+    Proc.setNonRealtime(true);
+    Proc.prepareToPlay(SampleRate, BlockSize);
+
+    //R1.02 Input is shared by all workers and never written. Output has room for the IR tail.
+    int InLen = Input.getNumSamples();
+    int OutLen = Output.getNumSamples();
+    for (int ch = 0; ch < 2; ch++)
+    {
+        Output.copyFrom(ch, 0, Input, juce::jmin(ch, Input.getNumChannels() - 1), 0, InLen);
+        Output.clear(ch, InLen, OutLen - InLen);
+    }
+
+    juce::MidiBuffer Midi;
+    for (int Pos = 0; Pos < OutLen; Pos += BlockSize)
+    {
+        int Len = juce::jmin(BlockSize, OutLen - Pos);
+        float* Chans[2] = { Output.getWritePointer(0, Pos), Output.getWritePointer(1, Pos) };
+        juce::AudioBuffer<float> Block(Chans, 2, Len);
+        Proc.processBlock(Block, Midi);
+    }
+
+    //R1.02 Write a 24 bit WAV file.
+    OutFile.deleteFile();
+    juce::WavAudioFormat Wav;
+    auto* Stream = new juce::FileOutputStream(OutFile);
+    if (! Stream->openedOk())
+    {
+        delete Stream;
+        return false;
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> Writer(Wav.createWriterFor(Stream, SampleRate, 2, 24, {}, 0));
+    if (Writer == nullptr) return false;
+
+    return Writer->writeFromAudioSampleBuffer(Output, 0, OutLen);
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList Args(argc, argv);
+    if (! Args.containsOption("--in") || ! Args.containsOption("--out") || ! Args.containsOption("--grid"))
+    {
+        std::cout << "Usage: MakoRustySweep --in file.wav --out dir --grid \"drive=.1,.5;ir=1,2\" [--threads N] [--block 512]" << std::endl;
+        return 1;
+    }
+
+    //R1.02 Message manager for the processor's preset timer.
+    juce::ScopedJuceInitialiser_GUI Juce;
+
+    juce::File InFile(Args.getValueForOption("--in"));
+    juce::File OutDir(Args.getValueForOption("--out"));
+    int Threads = Args.containsOption("--threads") ? Args.getValueForOption("--threads").getIntValue() : juce::SystemStats::getNumCpus();
+    int BlockSize = Args.containsOption("--block") ? Args.getValueForOption("--block").getIntValue() : 512;
+    Threads = juce::jmax(1, Threads);
+    BlockSize = juce::jlimit(16, 8192, BlockSize);
+
+    std::vector<t_SweepAxis> Axes;
+    if (! Mako_Sweep_ParseGrid(Args.getValueForOption("--grid"), Axes))
+    {
+        std::cout << "Bad grid. Expected id=v1,v2;id=v1,v2" << std::endl;
+        return 1;
+    }
+
+    //R1.02 Check every ID before we start rendering.
+    {
+        MakoBiteAudioProcessor Check;
+        for (auto& Axis : Axes)
+        {
+            if (Check.parameters.getParameter(Axis.ID) == nullptr)
+            {
+                std::cout << "Unknown parameter: " << Axis.ID.toRawUTF8() << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    //R1.02 Decode the input once. Every variant reads this same buffer.
+    juce::AudioFormatManager Formats;
+    Formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> Reader(Formats.createReaderFor(InFile));
+    if (Reader == nullptr)
+    {
+        std::cout << "Could not read: " << InFile.getFullPathName().toRawUTF8() << std::endl;
+        return 1;
+    }
+
+    double SampleRate = Reader->sampleRate;
+    int InLen = int(Reader->lengthInSamples);
+    juce::AudioBuffer<float> Input(int(juce::jmin(2u, Reader->numChannels)), InLen);
+    Reader->read(&Input, 0, InLen, 0, true, true);
+    Reader.reset();
+
+    //R1.02 Build every combination of the grid.
+    std::vector<t_SweepJob> Jobs(1);
+    for (auto& Axis : Axes)
+    {
+        std::vector<t_SweepJob> Next;
+        for (auto& Job : Jobs)
+        {
+            for (int v = 0; v < int(Axis.Values.size()); v++)
+            {
+                t_SweepJob J = Job;
+                J.ValueIdx.push_back(v);
+                Next.push_back(J);
+            }
+        }
+        Jobs = Next;
+    }
+
+    OutDir.createDirectory();
+    for (int t = 0; t < int(Jobs.size()); t++) Jobs[t].FileName = "sweep_" + juce::String(t + 1).paddedLeft('0', 4) + ".wav";
+
+    //R1.02 Deal the jobs out round robin. Stealing evens out the slow ones.
+    Threads = juce::jmin(Threads, int(Jobs.size()));
+    std::vector<t_SweepQueue> Queues(Threads);
+    for (int t = 0; t < int(Jobs.size()); t++) Queues[t % Threads].Jobs.push_back(t);
+
+    //R1.02 Allow 1024 samples after the input for the IR to ring out.
+    int OutLen = InLen + 1024;
+
+    std::vector<std::thread> Workers;
+    for (int w = 0; w < Threads; w++)
+    {
+        Workers.emplace_back([&, w]()
+        {
+            //R1.02 One processor and one output buffer per worker, reused for every job.
+            MakoBiteAudioProcessor Proc;
+            Proc.setPlayConfigDetails(2, 2, SampleRate, BlockSize);
+            juce::AudioBuffer<float> Output(2, OutLen);
+
+            for (int Job = Mako_Sweep_NextJob(Queues, w); 0 <= Job; Job = Mako_Sweep_NextJob(Queues, w))
+                Jobs[Job].Ok = Mako_Sweep_Render(Proc, Input, Output, Axes, Jobs[Job], SampleRate, BlockSize, OutDir.getChildFile(Jobs[Job].FileName));
+        });
+    }
+    for (auto& W : Workers) W.join();
+
+    //R1.02 Write the index so the renders can be matched to their settings.
+    juce::var Index;
+    int Failed = 0;
+    for (auto& Job : Jobs)
+    {
+        juce::DynamicObject::Ptr Entry = new juce::DynamicObject();
+        juce::DynamicObject::Ptr Parms = new juce::DynamicObject();
+        for (size_t a = 0; a < Axes.size(); a++) Parms->setProperty(Axes[a].ID, Axes[a].Values[Job.ValueIdx[a]]);
+
+        Entry->setProperty("file", Job.FileName);
+        Entry->setProperty("ok", Job.Ok);
+        Entry->setProperty("parameters", Parms.get());
+        Index.append(Entry.get());
+
+        if (! Job.Ok) Failed++;
+    }
+    OutDir.getChildFile("index.json").replaceWithText(juce::JSON::toString(Index));
+
+    std::cout << "Rendered " << (Jobs.size() - Failed) << " of " << Jobs.size() << " variants." << std::endl;
+    return (Failed == 0) ? 0 : 1;
+}